@@ -0,0 +1,832 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "benchmark.hpp"
+#include "game/game.hpp"
+#include "game/city.hpp"
+#include "game/tilemap.hpp"
+#include "game/cityservice_timers.hpp"
+#include "gfx/tile.hpp"
+#include "game/tilemap_camera.hpp"
+#include "gfx/city_renderer.hpp"
+#include "gfx/engine.hpp"
+#include "gfx/picture_bank.hpp"
+#include "game/resourcegroup.hpp"
+#include "gui/environment.hpp"
+#include "gui/topmenu.hpp"
+#include "gui/menu.hpp"
+#include "gui/rightpanel.hpp"
+#include "gui/minimap_window.hpp"
+#include "vfs/filelist.hpp"
+#include "vfs/filesystem.hpp"
+#include "vfs/archive.hpp"
+#include "core/random.hpp"
+#include "core/saveadapter.hpp"
+#include "core/json.hpp"
+#include "core/threadpool.hpp"
+#include "events/dispatcher.hpp"
+#include "core/logger.hpp"
+#include "core/stringhelper.hpp"
+#include "core/platform.hpp"
+#include "version.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#if defined(OC3_PLATFORM_WIN)
+  #include <windows.h>
+  #include <psapi.h>
+#elif defined(OC3_PLATFORM_UNIX)
+  #include <sys/time.h>
+  #include <sys/resource.h>
+#endif
+
+namespace
+{
+  unsigned long allocationsCount = 0;
+  unsigned long allocatedBytes = 0;
+  unsigned long peakAllocatedBytes = 0;
+
+  // camera path of render scenario: frames per side of square and step in tiles
+  const unsigned int pathSide = 50;
+  const int pathStep = 1;
+
+  // tilemap scenario reads every tile that many times
+  const unsigned int tilemapPasses = 200;
+
+  // every block keeps its size before user memory, aligned for any type
+  const std::size_t allocationHeader = 16;
+
+  unsigned long long getMicroseconds()
+  {
+#if defined(OC3_PLATFORM_WIN)
+    LARGE_INTEGER frequency, counter;
+    ::QueryPerformanceFrequency( &frequency );
+    ::QueryPerformanceCounter( &counter );
+    return (unsigned long long)( counter.QuadPart * 1000000.0 / frequency.QuadPart );
+#elif defined(OC3_PLATFORM_UNIX)
+    timeval tv;
+    gettimeofday( &tv, 0 );
+    return (unsigned long long)tv.tv_sec * 1000000 + tv.tv_usec;
+#endif
+  }
+
+  unsigned int getPeakRssKb()
+  {
+#if defined(OC3_PLATFORM_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    ::GetProcessMemoryInfo( ::GetCurrentProcess(), &counters, sizeof( counters ) );
+    return counters.PeakWorkingSetSize / 1024;
+#elif defined(OC3_PLATFORM_MACOSX)
+    rusage usage;
+    getrusage( RUSAGE_SELF, &usage );
+    return usage.ru_maxrss / 1024;  // bytes on mac
+#elif defined(OC3_PLATFORM_UNIX)
+    rusage usage;
+    getrusage( RUSAGE_SELF, &usage );
+    return usage.ru_maxrss;
+#endif
+  }
+
+  // FNV-1a of saved city and every walker in list order
+  unsigned int getStateHash( CityPtr city )
+  {
+    VariantMap vm_city;
+    city->save( vm_city );
+    std::string state = Json::serialize( vm_city.toVariant(), "" );
+
+    WalkerList walkers = city->getWalkers( constants::walker::all );
+    for( WalkerList::iterator it=walkers.begin(); it != walkers.end(); it++ )
+    {
+      VariantMap vm_walker;
+      (*it)->save( vm_walker );
+      state += Json::serialize( vm_walker.toVariant(), "" );
+    }
+
+    unsigned int hash = 2166136261u;
+    for( std::string::const_iterator it=state.begin(); it != state.end(); it++ )
+    {
+      hash = ( hash ^ (unsigned char)*it ) * 16777619u;
+    }
+
+    return hash;
+  }
+
+  unsigned int percentile( const std::vector< unsigned int >& sorted, unsigned int percent )
+  {
+    if( sorted.empty() )
+      return 0;
+
+    return sorted[ std::min<size_t>( sorted.size() * percent / 100, sorted.size() - 1 ) ];
+  }
+
+  struct Scenario
+  {
+    typedef enum { simulation, loader, render, tilemap, threads } Kind;
+
+    Kind kind;
+    std::string name;
+    io::FilePath filename;
+    io::FilePath replay;  // events fed while ticks run, empty if none
+    bool stress;
+    unsigned int frames;
+    bool gui;         // render scenario draws menus of game screen over city
+    bool cachedGui;   // menus are blitted from cached layers
+    unsigned int maxThreads;
+    StressCity::Options options;
+  };
+}
+
+// oc3_bench owns the global allocator to count allocations per tick
+#if __cplusplus >= 201103L
+  #define OC3_BENCH_THROW_BAD_ALLOC
+  #define OC3_BENCH_NOTHROW noexcept
+#else
+  #define OC3_BENCH_THROW_BAD_ALLOC throw( std::bad_alloc )
+  #define OC3_BENCH_NOTHROW throw()
+#endif
+
+void* operator new( std::size_t size ) OC3_BENCH_THROW_BAD_ALLOC
+{
+  ++allocationsCount;
+
+  char* ptr = (char*)std::malloc( size + allocationHeader );
+  if( !ptr )
+  {
+    throw std::bad_alloc();
+  }
+
+  *(std::size_t*)ptr = size;
+  allocatedBytes += size;
+  peakAllocatedBytes = std::max( peakAllocatedBytes, allocatedBytes );
+
+  return ptr + allocationHeader;
+}
+
+void* operator new[]( std::size_t size ) OC3_BENCH_THROW_BAD_ALLOC
+{
+  return operator new( size );
+}
+
+void operator delete( void* ptr ) OC3_BENCH_NOTHROW
+{
+  if( !ptr )
+    return;
+
+  char* block = (char*)ptr - allocationHeader;
+  allocatedBytes -= *(std::size_t*)block;
+  std::free( block );
+}
+
+void operator delete[]( void* ptr ) OC3_BENCH_NOTHROW
+{
+  operator delete( ptr );
+}
+
+#if __cplusplus >= 201402L
+// sized forms would go to library ones, which may skip the size header
+void operator delete( void* ptr, std::size_t ) OC3_BENCH_NOTHROW
+{
+  operator delete( ptr );
+}
+
+void operator delete[]( void* ptr, std::size_t ) OC3_BENCH_NOTHROW
+{
+  operator delete( ptr );
+}
+#endif
+
+class Benchmark::Impl
+{
+public:
+  Game& game;
+  std::vector< Scenario > scenarios;
+  unsigned int warmupTicks;
+  unsigned int ticks;
+  unsigned int seed;
+  VariantList results;
+
+  Impl( Game& g ) : game( g ) {}
+
+  VariantMap runScenario( const Scenario& scenario );
+  VariantMap runLoader( const Scenario& scenario );
+  VariantMap runRender( const Scenario& scenario );
+  VariantMap runTilemap( const Scenario& scenario );
+  VariantMap runThreads( const Scenario& scenario );
+
+  void createScreenMenus( CityPtr city, bool cached );
+};
+
+Benchmark::Benchmark( Game& game ) : _d( new Impl( game ) )
+{
+  _d->warmupTicks = 100;
+  _d->ticks = 1000;
+  _d->seed = 0x9e3779b9;
+}
+
+Benchmark::~Benchmark()
+{
+
+}
+
+void Benchmark::addScenario( const io::FilePath& filename )
+{
+  Scenario scenario;
+  scenario.name = filename.getBasename().toString();
+  scenario.filename = filename;
+  scenario.kind = Scenario::simulation;
+  scenario.stress = false;
+
+  _d->scenarios.push_back( scenario );
+}
+
+void Benchmark::addScenarios( const io::FilePath& directory )
+{
+  io::FileList::Items items = io::FileDir( directory ).getEntries().filter( io::FileList::file, "" ).getItems();
+  for( io::FileList::ItemIt it=items.begin(); it != items.end(); it++ )
+  {
+    const io::FilePath& path = it->fullName;
+    if( path.isExtension( ".map" ) || path.isExtension( ".sav" ) || path.isExtension( ".oc3save" ) )
+    {
+      addScenario( path );
+    }
+  }
+}
+
+void Benchmark::addStressCity( const StressCity::Options& options, const io::FilePath& filename )
+{
+  if( !StressCity::generate( _d->game, options, filename ) )
+  {
+    Logger::warning( "Benchmark: can't generate stress city" );
+    return;
+  }
+
+  Scenario scenario;
+  scenario.name = "stress";
+  scenario.filename = filename;
+  scenario.kind = Scenario::simulation;
+  scenario.stress = true;
+  scenario.options = options;
+
+  _d->scenarios.push_back( scenario );
+}
+
+void Benchmark::addThreads( const StressCity::Options& options, const io::FilePath& filename,
+                            unsigned int maxThreads )
+{
+  Scenario scenario;
+  scenario.name = "threads";
+  scenario.filename = filename;
+  scenario.kind = Scenario::threads;
+  scenario.stress = true;
+  scenario.options = options;
+  scenario.maxThreads = maxThreads;
+
+  _d->scenarios.push_back( scenario );
+}
+
+void Benchmark::addReplay( const io::FilePath& filename )
+{
+  VariantMap vm_replay = SaveAdapter::load( filename );
+  std::string save = vm_replay.get( "save" ).toString();
+  if( save.empty() )
+  {
+    Logger::warning( "Benchmark: replay %s has no save", filename.toString().c_str() );
+    return;
+  }
+
+  Scenario scenario;
+  scenario.name = "replay_" + filename.getBasename().toString();
+  scenario.filename = save;
+  scenario.replay = filename;
+  scenario.kind = Scenario::simulation;
+  scenario.stress = false;
+
+  _d->scenarios.push_back( scenario );
+}
+
+void Benchmark::addLoader()
+{
+  Scenario scenario;
+  scenario.name = "loader";
+  scenario.kind = Scenario::loader;
+  scenario.stress = false;
+
+  _d->scenarios.push_back( scenario );
+}
+
+void Benchmark::addRender( const io::FilePath& filename, unsigned int frames )
+{
+  Scenario scenario;
+  scenario.name = "render";
+  scenario.filename = filename;
+  scenario.kind = Scenario::render;
+  scenario.stress = false;
+  scenario.frames = frames;
+  scenario.gui = false;
+  scenario.cachedGui = false;
+
+  _d->scenarios.push_back( scenario );
+}
+
+void Benchmark::addScreen( const io::FilePath& filename, unsigned int frames, bool cachedGui )
+{
+  Scenario scenario;
+  scenario.name = cachedGui ? "screen_cached_gui" : "screen";
+  scenario.filename = filename;
+  scenario.kind = Scenario::render;
+  scenario.stress = false;
+  scenario.frames = frames;
+  scenario.gui = true;
+  scenario.cachedGui = cachedGui;
+
+  _d->scenarios.push_back( scenario );
+}
+
+void Benchmark::addTilemap( const io::FilePath& filename )
+{
+  Scenario scenario;
+  scenario.name = "tilemap";
+  scenario.filename = filename;
+  scenario.kind = Scenario::tilemap;
+  scenario.stress = false;
+
+  _d->scenarios.push_back( scenario );
+}
+
+void Benchmark::setTicks( unsigned int warmup, unsigned int measured )
+{
+  _d->warmupTicks = warmup;
+  _d->ticks = measured;
+}
+
+void Benchmark::setSeed( unsigned int seed )
+{
+  _d->seed = seed;
+}
+
+void Benchmark::run()
+{
+  _d->results.clear();
+  for( std::vector< Scenario >::const_iterator it=_d->scenarios.begin(); it != _d->scenarios.end(); it++ )
+  {
+    Logger::warning( "Benchmark: run %s", it->name.c_str() );
+    switch( it->kind )
+    {
+    case Scenario::loader:  _d->results.push_back( _d->runLoader( *it ) ); break;
+    case Scenario::render:  _d->results.push_back( _d->runRender( *it ) ); break;
+    case Scenario::tilemap: _d->results.push_back( _d->runTilemap( *it ) ); break;
+    case Scenario::threads: _d->results.push_back( _d->runThreads( *it ) ); break;
+    default:                _d->results.push_back( _d->runScenario( *it ) ); break;
+    }
+  }
+}
+
+VariantMap Benchmark::Impl::runScenario( const Scenario& scenario )
+{
+  VariantMap ret;
+  ret[ "name" ] = Variant( scenario.name );
+  ret[ "file" ] = Variant( scenario.filename.toString() );
+  if( !scenario.replay.toString().empty() )
+  {
+    ret[ "replay" ] = Variant( scenario.replay.toString() );
+  }
+
+  game.reset();
+
+  // loading a save parses Variant maps and lists, count what it costs
+  unsigned long loadAllocations = allocationsCount;
+  unsigned long long loadStart = getMicroseconds();
+  game.load( scenario.filename.toString() );
+  ret[ "load_us" ] = (unsigned int)( getMicroseconds() - loadStart );
+  ret[ "load_allocations" ] = (unsigned int)( allocationsCount - loadAllocations );
+
+  CityPtr city = game.getCity();
+  if( city->getTilemap().getSize() == 0 )
+  {
+    ret[ "error" ] = Variant( std::string( "can't load scenario" ) );
+    return ret;
+  }
+
+  // replay brings random state of the recorded game
+  if( !scenario.replay.toString().empty() )
+  {
+    events::Dispatcher::startReplay( scenario.replay, city->getRandom() );
+  }
+  else
+  {
+    city->getRandom().setSeed( seed );
+  }
+
+  if( scenario.stress )
+  {
+    StressCity::populate( game, scenario.options );
+  }
+
+  game.step( warmupTicks );
+
+  std::vector< unsigned int > times;
+  times.reserve( ticks );
+
+  // periodic work of overlays and services runs as timer callbacks
+  CityServiceTimers& timers = CityServiceTimers::getInstance();
+  unsigned long long callbacks = 0;
+  unsigned int maxCallbacks = 0;
+
+  unsigned long allocations = allocationsCount;
+  unsigned long long start = getMicroseconds();
+  for( unsigned int k=0; k < ticks; k++ )
+  {
+    unsigned long long tickStart = getMicroseconds();
+    game.step();
+    times.push_back( (unsigned int)( getMicroseconds() - tickStart ) );
+
+    callbacks += timers.getDueCount();
+    maxCallbacks = std::max( maxCallbacks, timers.getDueCount() );
+  }
+
+  unsigned long long total = std::max<unsigned long long>( getMicroseconds() - start, 1 );
+  allocations = allocationsCount - allocations;
+
+  events::Dispatcher::stopReplay();
+
+  std::sort( times.begin(), times.end() );
+
+  ret[ "ticks" ] = ticks;
+  ret[ "total_us" ] = (unsigned int)total;
+  ret[ "ticks_per_second" ] = (unsigned int)( ticks * 1000000ull / total );
+  ret[ "p50_us" ] = percentile( times, 50 );
+  ret[ "p99_us" ] = percentile( times, 99 );
+  ret[ "max_us" ] = times.empty() ? 0u : times.back();
+  ret[ "allocations" ] = (unsigned int)allocations;
+  ret[ "allocations_per_tick" ] = ticks > 0 ? (unsigned int)( allocations / ticks ) : 0u;
+  ret[ "timer_callbacks_per_tick" ] = ticks > 0 ? (unsigned int)( callbacks / ticks ) : 0u;
+  ret[ "timer_callbacks_max" ] = maxCallbacks;
+  ret[ "overlays" ] = (unsigned int)city->getOverlays().size();
+  ret[ "walkers" ] = (unsigned int)city->getWalkers( constants::walker::all ).size();
+  ret[ "peak_rss_kb" ] = getPeakRssKb();
+
+  return ret;
+}
+
+VariantMap Benchmark::Impl::runLoader( const Scenario& scenario )
+{
+  VariantMap ret;
+  ret[ "name" ] = Variant( scenario.name );
+
+  io::FileSystem& fs = io::FileSystem::instance();
+
+  std::vector< unsigned int > times;
+  unsigned int files = 0;
+  unsigned long long bytes = 0;
+  char buffer[ 4096 ];
+
+  unsigned long allocations = allocationsCount;
+  unsigned long baseBytes = allocatedBytes;
+  peakAllocatedBytes = allocatedBytes;
+
+  unsigned long long start = getMicroseconds();
+  for( unsigned int i=0; i < fs.getFileArchiveCount(); i++ )
+  {
+    io::ArchivePtr archive = fs.getFileArchive( i );
+    const io::FileList* list = archive->getFileList();
+    for( unsigned int k=0; k < list->getFileCount(); k++ )
+    {
+      if( list->isDirectory( k ) )
+        continue;
+
+      unsigned long long fileStart = getMicroseconds();
+      io::NFile file = archive->createAndOpenFile( k );
+
+      // consumers read files by chunks, like png reader does
+      int readed = 0;
+      while( (readed = file.read( buffer, sizeof( buffer ) )) > 0 )
+      {
+        bytes += readed;
+      }
+
+      times.push_back( (unsigned int)( getMicroseconds() - fileStart ) );
+      files++;
+    }
+  }
+
+  unsigned long long total = std::max<unsigned long long>( getMicroseconds() - start, 1 );
+  allocations = allocationsCount - allocations;
+
+  std::sort( times.begin(), times.end() );
+
+  ret[ "archives" ] = fs.getFileArchiveCount();
+  ret[ "files" ] = files;
+  ret[ "read_kb" ] = (unsigned int)( bytes / 1024 );
+  ret[ "total_us" ] = (unsigned int)total;
+  ret[ "p50_us" ] = percentile( times, 50 );
+  ret[ "p99_us" ] = percentile( times, 99 );
+  ret[ "max_us" ] = times.empty() ? 0u : times.back();
+  ret[ "allocations" ] = (unsigned int)allocations;
+  ret[ "peak_heap_kb" ] = (unsigned int)( (peakAllocatedBytes - baseBytes) / 1024 );
+  ret[ "peak_rss_kb" ] = getPeakRssKb();
+
+  return ret;
+}
+
+VariantMap Benchmark::Impl::runRender( const Scenario& scenario )
+{
+  VariantMap ret;
+  ret[ "name" ] = Variant( scenario.name );
+  ret[ "file" ] = Variant( scenario.filename.toString() );
+
+  game.reset();
+  game.load( scenario.filename.toString() );
+
+  CityPtr city = game.getCity();
+  if( city->getTilemap().getSize() == 0 )
+  {
+    ret[ "error" ] = Variant( std::string( "can't load scenario" ) );
+    return ret;
+  }
+
+  GfxEngine& engine = GfxEngine::instance();
+  CityRenderer renderer;
+  renderer.initialize( city, &engine );
+
+  TilemapCamera& camera = renderer.getCamera();
+  camera.setViewport( engine.getScreenSize() + Size( 180 ) );
+
+  gui::GuiEnv& gui = *game.getGui();
+  if( scenario.gui )
+  {
+    createScreenMenus( city, scenario.cachedGui );
+  }
+
+  // camera goes round a square around map center, first lap loads pictures
+  const int mapSize = city->getTilemap().getSize();
+  const unsigned int lap = 4 * pathSide;
+  std::vector< unsigned int > times;
+  times.reserve( scenario.frames );
+
+  unsigned long long start = 0;
+  unsigned long allocations = 0;
+  camera.setCenter( TilePos( mapSize / 2, mapSize / 2 ) );
+  for( unsigned int k=0; k < lap + scenario.frames; k++ )
+  {
+    switch( (k / pathSide) % 4 )
+    {
+    case 0: camera.moveRight( pathStep ); break;
+    case 1: camera.moveDown( pathStep ); break;
+    case 2: camera.moveLeft( pathStep ); break;
+    case 3: camera.moveUp( pathStep ); break;
+    }
+
+    if( k == lap )
+    {
+      start = getMicroseconds();
+      allocations = allocationsCount;
+    }
+
+    unsigned long long frameStart = getMicroseconds();
+    renderer.animate( k );
+    engine.startRenderFrame();
+    renderer.render();
+
+    if( scenario.gui )
+    {
+      gui.beforeDraw();
+      gui.draw();
+    }
+
+    engine.endRenderFrame();
+
+    if( k >= lap )
+    {
+      times.push_back( (unsigned int)( getMicroseconds() - frameStart ) );
+    }
+  }
+
+  unsigned long long total = std::max<unsigned long long>( getMicroseconds() - start, 1 );
+  allocations = allocationsCount - allocations;
+
+  std::sort( times.begin(), times.end() );
+
+  ret[ "frames" ] = scenario.frames;
+  ret[ "total_us" ] = (unsigned int)total;
+  ret[ "frames_per_second" ] = (unsigned int)( scenario.frames * 1000000ull / total );
+  ret[ "p50_us" ] = percentile( times, 50 );
+  ret[ "p99_us" ] = percentile( times, 99 );
+  ret[ "max_us" ] = times.empty() ? 0u : times.back();
+  ret[ "allocations_per_frame" ] = scenario.frames > 0 ? (unsigned int)( allocations / scenario.frames ) : 0u;
+  ret[ "rle_sprites" ] = engine.getFlag( GfxEngine::rleSprites ) != 0;
+  ret[ "gui" ] = scenario.gui;
+  ret[ "cached_gui" ] = scenario.cachedGui;
+  ret[ "sprites_kb" ] = PictureBank::instance().getMemorySize() / 1024;
+  ret[ "peak_rss_kb" ] = getPeakRssKb();
+
+  if( scenario.gui )
+  {
+    gui.clear();
+    gui.beforeDraw();
+  }
+
+  return ret;
+}
+
+void Benchmark::Impl::createScreenMenus( CityPtr city, bool cached )
+{
+  // same layout as game screen has
+  GfxEngine& engine = GfxEngine::instance();
+  gui::Widget* root = game.getGui()->getRootWidget();
+
+  const int topMenuHeight = 23;
+  const Picture& rPanelPic = Picture::load( ResourceGroup::panelBackground, 14 );
+  Rect rPanelRect( engine.getScreenWidth() - rPanelPic.getWidth(), topMenuHeight,
+                   engine.getScreenWidth(), engine.getScreenHeight() );
+
+  gui::MenuRigthPanel* rightPanel = gui::MenuRigthPanel::create( root, rPanelRect, rPanelPic );
+  gui::TopMenu* topMenu = new gui::TopMenu( root, topMenuHeight );
+
+  gui::Menu* menu = gui::Menu::create( root, -1, city );
+  menu->setPosition( Point( engine.getScreenWidth() - menu->getWidth() - rightPanel->getWidth(), topMenuHeight ) );
+
+  gui::ExtentMenu* extMenu = gui::ExtentMenu::create( root, -1, city );
+  extMenu->setPosition( Point( engine.getScreenWidth() - extMenu->getWidth() - rightPanel->getWidth(), topMenuHeight ) );
+
+  new gui::Minimap( extMenu, Rect( 8, 35, 8 + 144, 35 + 110 ), city );
+
+  rightPanel->bringToFront();
+
+  topMenu->setCached( cached );
+  menu->setCached( cached );
+  extMenu->setCached( cached );
+}
+
+VariantMap Benchmark::Impl::runTilemap( const Scenario& scenario )
+{
+  VariantMap ret;
+  ret[ "name" ] = Variant( scenario.name );
+  ret[ "file" ] = Variant( scenario.filename.toString() );
+
+  game.reset();
+  game.load( scenario.filename.toString() );
+
+  Tilemap& tilemap = game.getCity()->getTilemap();
+  const int size = tilemap.getSize();
+  if( size == 0 )
+  {
+    ret[ "error" ] = Variant( std::string( "can't load scenario" ) );
+    return ret;
+  }
+
+  // pathfinding and services read flags of whole map rows, do the same
+  unsigned int found = 0;
+  unsigned long long start = getMicroseconds();
+  for( unsigned int pass=0; pass < tilemapPasses; pass++ )
+  {
+    for( int i=0; i < size; i++ )
+    {
+      for( int j=0; j < size; j++ )
+      {
+        found += tilemap.at( i, j ).isWalkable( true ) ? 1 : 0;
+      }
+    }
+  }
+  unsigned long long walkableTime = std::max<unsigned long long>( getMicroseconds() - start, 1 );
+
+  start = getMicroseconds();
+  for( unsigned int pass=0; pass < tilemapPasses; pass++ )
+  {
+    for( int i=0; i < size; i++ )
+    {
+      for( int j=0; j < size; j++ )
+      {
+        const Tile& tile = tilemap.at( i, j );
+        found += tile.getFlag( Tile::tlRoad ) ? 1 : 0;
+        found += tile.getFlag( Tile::isConstructible ) ? 1 : 0;
+      }
+    }
+  }
+  unsigned long long flagTime = std::max<unsigned long long>( getMicroseconds() - start, 1 );
+
+  unsigned long long calls = (unsigned long long)tilemapPasses * size * size;
+
+  ret[ "tiles" ] = size * size;
+  ret[ "tile_bytes" ] = (unsigned int)sizeof( Tile );
+  ret[ "tilemap_kb" ] = (unsigned int)( sizeof( Tile ) * size * size / 1024 );
+  ret[ "walkable_ns" ] = (unsigned int)( walkableTime * 1000 / calls );
+  ret[ "get_flag_ns" ] = (unsigned int)( flagTime * 1000 / (calls * 2) );
+  ret[ "found" ] = found;
+
+  return ret;
+}
+
+VariantMap Benchmark::getReport() const
+{
+  VariantMap ret;
+  ret[ "version" ] = Variant( StringHelper::format( 0xff, "%d.%d.%d", OC3_VERSION_MAJOR,
+                                                     OC3_VERSION_MINOR, OC3_VERSION_REVSN ) );
+  ret[ "platform" ] = Variant( std::string( OC3_PLATFORM_NAME ) );
+  ret[ "seed" ] = _d->seed;
+  ret[ "warmup_ticks" ] = _d->warmupTicks;
+  ret[ "ticks" ] = _d->ticks;
+  ret[ "peak_rss_kb" ] = getPeakRssKb();
+  ret[ "scenarios" ] = _d->results;
+
+  return ret;
+}
+
+VariantMap Benchmark::Impl::runThreads( const Scenario& scenario )
+{
+  VariantMap ret;
+  ret[ "name" ] = Variant( scenario.name );
+  ret[ "file" ] = Variant( scenario.filename.toString() );
+  ret[ "cpu_count" ] = ThreadPool::getCpuCount();
+
+  ThreadPool& pool = ThreadPool::instance();
+  const unsigned int defaultThreads = pool.getThreadsCount();
+
+  VariantList runs;
+  unsigned int singleHash = 0;
+  unsigned long long singleTotal = 0;
+  bool identical = true;
+  for( unsigned int threads=1; threads <= std::max( scenario.maxThreads, 1u ); threads *= 2 )
+  {
+    pool.setThreadsCount( threads );
+
+    // some buildings still draw from rand(), every run starts from the same state
+    srand( seed );
+    game.reset();
+    game.load( scenario.filename.toString() );
+
+    CityPtr city = game.getCity();
+    if( city->getTilemap().getSize() == 0 )
+    {
+      ret[ "error" ] = Variant( std::string( "can't load scenario" ) );
+      break;
+    }
+
+    city->getRandom().setSeed( seed );
+    StressCity::populate( game, scenario.options );
+    game.step( warmupTicks );
+
+    std::vector< unsigned int > times;
+    times.reserve( ticks );
+
+    unsigned long long start = getMicroseconds();
+    for( unsigned int k=0; k < ticks; k++ )
+    {
+      unsigned long long tickStart = getMicroseconds();
+      game.step();
+      times.push_back( (unsigned int)( getMicroseconds() - tickStart ) );
+    }
+    unsigned long long total = std::max<unsigned long long>( getMicroseconds() - start, 1 );
+
+    const unsigned int hash = getStateHash( city );
+    if( threads == 1 )
+    {
+      singleHash = hash;
+      singleTotal = total;
+    }
+    identical = identical && ( hash == singleHash );
+
+    std::sort( times.begin(), times.end() );
+
+    VariantMap run;
+    run[ "threads" ] = pool.getThreadsCount();
+    run[ "total_us" ] = (unsigned int)total;
+    run[ "p50_us" ] = percentile( times, 50 );
+    run[ "p99_us" ] = percentile( times, 99 );
+    run[ "speedup" ] = (float)singleTotal / (float)total;
+    run[ "state_hash" ] = Variant( StringHelper::format( 0xff, "%08x", hash ) );
+    runs.push_back( run );
+  }
+
+  pool.setThreadsCount( defaultThreads );
+
+  ret[ "ticks" ] = ticks;
+  ret[ "runs" ] = runs;
+  ret[ "identical" ] = identical;
+
+  return ret;
+}
+
+unsigned long Benchmark::getAllocationsCount()
+{
+  return allocationsCount;
+}
+
+unsigned long Benchmark::getAllocatedBytes()
+{
+  return allocatedBytes;
+}
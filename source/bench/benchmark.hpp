@@ -0,0 +1,75 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __OPENCAESAR3_BENCHMARK_H_INCLUDED__
+#define __OPENCAESAR3_BENCHMARK_H_INCLUDED__
+
+#include "core/scopedptr.hpp"
+#include "core/variant.hpp"
+#include "vfs/filepath.hpp"
+#include "stress_city.hpp"
+
+class Game;
+
+// runs a fixed number of simulation ticks on every scenario and collects
+// tick times and allocation counts, the report is written as json
+class Benchmark
+{
+public:
+  Benchmark( Game& game );
+  ~Benchmark();
+
+  void addScenario( const io::FilePath& filename );
+  void addScenarios( const io::FilePath& directory );
+  void addStressCity( const StressCity::Options& options, const io::FilePath& filename );
+
+  // runs stress city with 1, 2, 4... maxThreads threads in think phase, reports
+  // speedup and state hash of city after every run, hashes must be equal
+  void addThreads( const StressCity::Options& options, const io::FilePath& filename,
+                   unsigned int maxThreads );
+
+  // runs recorded player input over the save it was recorded on,
+  // with the recorded random state
+  void addReplay( const io::FilePath& filename );
+
+  // opens and reads every entry of mounted archives, the way sprites are loaded
+  void addLoader();
+
+  // draws frames of the city while camera goes along a fixed path
+  void addRender( const io::FilePath& filename, unsigned int frames );
+
+  // same as render, with menus of game screen drawn over city
+  void addScreen( const io::FilePath& filename, unsigned int frames, bool cachedGui );
+
+  // reads flags of every tile, reports tile size and time per call
+  void addTilemap( const io::FilePath& filename );
+
+  void setTicks( unsigned int warmup, unsigned int measured );
+  void setSeed( unsigned int seed );
+
+  void run();
+
+  VariantMap getReport() const;
+
+  // counted by the global operator new of oc3_bench
+  static unsigned long getAllocationsCount();
+  static unsigned long getAllocatedBytes();
+
+private:
+  class Impl;
+  ScopedPtr< Impl > _d;
+};
+
+#endif //__OPENCAESAR3_BENCHMARK_H_INCLUDED__
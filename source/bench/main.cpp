@@ -0,0 +1,165 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "benchmark.hpp"
+#include "stress_city.hpp"
+#include "game/game.hpp"
+#include "game/settings.hpp"
+#include "core/exception.hpp"
+#include "core/logger.hpp"
+#include "core/json.hpp"
+#include "core/saveadapter.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// usage: oc3_bench [-R resources] [-ticks N] [-warmup N] [-seed N]
+//                  [-houses N] [-workshops N] [-aqueducts N] [-walkers N]
+//                  [-scenario file] [-replay file] [-nostress] [-noloader] [-norender]
+//                  [-frames N] [-rle on|off] [-threads N] [-o report.json]
+int main(int argc, char* argv[])
+{
+  StressCity::Options stress;
+  unsigned int ticks = 1000;
+  unsigned int warmup = 100;
+  unsigned int seed = 0x9e3779b9;
+  bool useStress = true;
+  bool useLoader = true;
+  bool useRender = true;
+  unsigned int frames = 400;
+  unsigned int maxThreads = 16;
+  std::vector< std::string > scenarios;
+  std::vector< std::string > replays;
+  std::string output;
+
+  for( int i = 1; i < argc; i++ )
+  {
+    if( !strcmp( argv[i], "-nostress" ) )
+    {
+      useStress = false;
+      continue;
+    }
+
+    if( !strcmp( argv[i], "-noloader" ) )
+    {
+      useLoader = false;
+      continue;
+    }
+
+    if( !strcmp( argv[i], "-norender" ) )
+    {
+      useRender = false;
+      continue;
+    }
+
+    if( i + 1 >= argc )
+      break;
+
+    if( !strcmp( argv[i], "-R" ) )
+    {
+      std::string path = argv[i+1];
+      GameSettings::set( GameSettings::resourcePath, Variant( path ) );
+      GameSettings::set( GameSettings::localePath, Variant( path + "/locale" ) );
+      i++;
+    }
+    else if( !strcmp( argv[i], "-ticks" ) )     { ticks = atoi( argv[++i] ); }
+    else if( !strcmp( argv[i], "-warmup" ) )    { warmup = atoi( argv[++i] ); }
+    else if( !strcmp( argv[i], "-seed" ) )      { seed = strtoul( argv[++i], 0, 0 ); }
+    else if( !strcmp( argv[i], "-houses" ) )    { stress.houses = atoi( argv[++i] ); }
+    else if( !strcmp( argv[i], "-workshops" ) ) { stress.workshops = atoi( argv[++i] ); }
+    else if( !strcmp( argv[i], "-aqueducts" ) ) { stress.aqueducts = atoi( argv[++i] ); }
+    else if( !strcmp( argv[i], "-walkers" ) )   { stress.walkers = atoi( argv[++i] ); }
+    else if( !strcmp( argv[i], "-scenario" ) )  { scenarios.push_back( argv[++i] ); }
+    else if( !strcmp( argv[i], "-replay" ) )    { replays.push_back( argv[++i] ); }
+    else if( !strcmp( argv[i], "-frames" ) )    { frames = atoi( argv[++i] ); }
+    else if( !strcmp( argv[i], "-threads" ) )   { maxThreads = atoi( argv[++i] ); }
+    else if( !strcmp( argv[i], "-o" ) )         { output = argv[++i]; }
+    else if( !strcmp( argv[i], "-rle" ) )
+    {
+      GameSettings::set( GameSettings::rleSprites, Variant( !strcmp( argv[i+1], "on" ) ) );
+      i++;
+    }
+  }
+
+  // no window and no sound, frames are drawn to the dummy video surface
+  putenv( const_cast< char* >( "SDL_VIDEODRIVER=dummy" ) );
+  putenv( const_cast< char* >( "SDL_AUDIODRIVER=dummy" ) );
+
+  try
+  {
+    Game game;
+    game.initialize();
+
+    Benchmark bench( game );
+    bench.setTicks( warmup, ticks );
+    bench.setSeed( seed );
+
+    if( useLoader )
+    {
+      bench.addLoader();
+    }
+
+    if( useStress )
+    {
+      bench.addStressCity( stress, "stress_city.oc3save" );
+      bench.addTilemap( "stress_city.oc3save" );
+      bench.addThreads( stress, "stress_city.oc3save", maxThreads );
+      if( useRender )
+      {
+        bench.addRender( "stress_city.oc3save", frames );
+        bench.addScreen( "stress_city.oc3save", frames, false );
+        bench.addScreen( "stress_city.oc3save", frames, true );
+      }
+    }
+
+    if( scenarios.empty() )
+    {
+      bench.addScenarios( GameSettings::rcpath( "/maps/" ) );
+      bench.addScenarios( GameSettings::rcpath( "/savs/" ) );
+    }
+    else
+    {
+      for( std::vector< std::string >::iterator it=scenarios.begin(); it != scenarios.end(); it++ )
+      {
+        bench.addScenario( *it );
+      }
+    }
+
+    for( std::vector< std::string >::iterator it=replays.begin(); it != replays.end(); it++ )
+    {
+      bench.addReplay( *it );
+    }
+
+    bench.run();
+
+    VariantMap report = bench.getReport();
+    if( !output.empty() )
+    {
+      SaveAdapter::save( report, output );
+    }
+
+    std::cout << Json::serialize( report.toVariant(), " " ) << std::endl;
+  }
+  catch( Exception e )
+  {
+    Logger::error( "FATAL ERROR: %s", e.getDescription().c_str() );
+    return 1;
+  }
+
+  Logger::flush();
+  return 0;
+}
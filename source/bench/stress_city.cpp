@@ -0,0 +1,190 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "stress_city.hpp"
+#include "game/game.hpp"
+#include "game/city.hpp"
+#include "game/tilemap.hpp"
+#include "game/tileoverlay_factory.hpp"
+#include "game/construction.hpp"
+#include "events/event.hpp"
+#include "walker/patrician.hpp"
+#include "building/constants.hpp"
+#include "core/random.hpp"
+#include "core/logger.hpp"
+#include "core/math.hpp"
+
+#include <set>
+
+using namespace constants;
+
+namespace
+{
+  static const int mapSize = 162;
+  static const int blockSize = 6;           // road line and five tiles of buildings
+  static const int blockCount = mapSize / blockSize;
+  static const int grassImgId = 244 + 62;   // land1a_00062
+  static const int waterImgId = 244 + 120;  // land1a_00120
+
+  bool build( Game& game, const TilePos& pos, TileOverlay::Type type )
+  {
+    TileOverlayPtr overlay = TileOverlayFactory::getInstance().create( type );
+    ConstructionPtr construction = overlay.as<Construction>();
+    if( construction.isNull() || !construction->canBuild( game.getCity(), pos ) )
+    {
+      return false;
+    }
+
+    events::GameEventPtr event = events::BuildEvent::create( pos, overlay );
+    event->exec( game );
+    return true;
+  }
+
+  TilePos blockStart( int bi, int bj )
+  {
+    return TilePos( bi * blockSize + 1, bj * blockSize + 1 );
+  }
+}
+
+bool StressCity::generate( Game& game, const Options& options, const io::FilePath& filename )
+{
+  game.reset();
+
+  CityPtr city = game.getCity();
+  city->setName( "stress" );
+
+  Tilemap& tilemap = city->getTilemap();
+  tilemap.resize( mapSize );
+
+  // grass everywhere and a river along the west border for the reservoirs
+  for( int i=0; i < mapSize; i++ )
+  {
+    for( int j=0; j < mapSize; j++ )
+    {
+      Tile& tile = tilemap.at( i, j );
+      bool water = (j == 0);
+      int imgId = water ? waterImgId : grassImgId;
+
+      tile.setFlag( Tile::tlWater, water );
+      tile.setOriginalImgId( imgId );
+      tile.setPicture( TileHelper::convId2PicName( imgId ) );
+    }
+  }
+
+  BorderInfo border;
+  border.roadEntry = TilePos( blockSize, mapSize - 1 );
+  border.roadExit = TilePos( (blockCount - 1) * blockSize, mapSize - 1 );
+  border.boatEntry = TilePos( 0, 0 );
+  border.boatExit = TilePos( mapSize - 1, 0 );
+  city->setBorderInfo( border );
+
+  for( int i=1; i < mapSize; i++ )
+  {
+    for( int j=1; j < mapSize; j++ )
+    {
+      if( i % blockSize == 0 || j % blockSize == 0 )
+      {
+        build( game, TilePos( i, j ), construction::road );
+      }
+    }
+  }
+
+  // aqueduct lines take whole block rows, spread over the map; each one
+  // starts from a reservoir on the river and crosses every vertical road
+  std::set< int > aqueductRows;
+  int aqueducts = math::clamp( options.aqueducts, 0, blockCount );
+  for( int k=0; k < aqueducts; k++ )
+  {
+    int bi = k * blockCount / aqueducts;
+    aqueductRows.insert( bi );
+
+    TilePos start = blockStart( bi, 0 );
+    build( game, start + TilePos( 1, 0 ), building::B_RESERVOIR );
+    for( int j=start.getJ() + 3; j < mapSize; j++ )
+    {
+      build( game, TilePos( start.getI() + 2, j ), building::B_AQUEDUCT );
+    }
+  }
+
+  // every fourth free block holds four potteries, the rest hold a ring of houses
+  int houses = 0, workshops = 0;
+  for( int bi=0; bi < blockCount; bi++ )
+  {
+    if( aqueductRows.count( bi ) > 0 )
+      continue;
+
+    for( int bj=0; bj < blockCount; bj++ )
+    {
+      TilePos start = blockStart( bi, bj );
+      bool workshopBlock = ((bi + bj) % 4 == 0 && workshops < options.workshops)
+                           || houses >= options.houses;
+
+      if( workshopBlock )
+      {
+        for( int k=0; k < 4 && workshops < options.workshops; k++ )
+        {
+          TilePos offset( (k / 2) * 3, (k % 2) * 3 );
+          workshops += build( game, start + offset, building::pottery ) ? 1 : 0;
+        }
+      }
+      else
+      {
+        for( int di=0; di < blockSize - 1 && houses < options.houses; di++ )
+        {
+          for( int dj=0; dj < blockSize - 1 && houses < options.houses; dj++ )
+          {
+            bool ring = (di == 0 || dj == 0 || di == blockSize - 2 || dj == blockSize - 2);
+            if( ring )
+            {
+              houses += build( game, start + TilePos( di, dj ), building::house ) ? 1 : 0;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  Logger::warning( "Stress city: %d houses, %d workshops, %d aqueduct lines",
+                   houses, workshops, aqueducts );
+
+  game.save( filename.toString() );
+  return houses > 0;
+}
+
+void StressCity::populate( Game& game, const Options& options )
+{
+  CityPtr city = game.getCity();
+  Tilemap& tilemap = city->getTilemap();
+  if( tilemap.getSize() != mapSize )
+  {
+    return;
+  }
+
+  // patricians wander from random points of the horizontal roads
+  for( int k=0; k < options.walkers; k++ )
+  {
+    TilePos pos( blockSize * (1 + city->getRandom().get() % (blockCount - 1)),
+                 1 + city->getRandom().get() % (mapSize - 1) );
+
+    if( !tilemap.at( pos ).getFlag( Tile::tlRoad ) )
+      continue;
+
+    Patrician* patrician = new Patrician( city );
+    WalkerPtr walker( patrician );
+    walker->drop();
+
+    patrician->send2City( pos );
+  }
+}
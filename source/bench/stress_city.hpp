@@ -0,0 +1,49 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __OPENCAESAR3_STRESS_CITY_H_INCLUDED__
+#define __OPENCAESAR3_STRESS_CITY_H_INCLUDED__
+
+#include "vfs/filepath.hpp"
+
+class Game;
+
+// generated 162x162 city for oc3_bench: road grid with blocks of houses and
+// potteries, long aqueduct lines fed from a river and wandering patricians
+class StressCity
+{
+public:
+  struct Options
+  {
+    int houses;
+    int workshops;
+    int aqueducts;
+    int walkers;
+
+    Options() : houses( 3000 ), workshops( 200 ), aqueducts( 8 ), walkers( 2000 ) {}
+  };
+
+  // builds the city in game and writes it to filename, so every run
+  // goes through the same loader as a normal save
+  static bool generate( Game& game, const Options& options, const io::FilePath& filename );
+
+  // patricians can not be restored from save, spawn them after load
+  static void populate( Game& game, const Options& options );
+
+private:
+  StressCity();
+};
+
+#endif //__OPENCAESAR3_STRESS_CITY_H_INCLUDED__
@@ -53,17 +53,27 @@ void Building::initTerrain( Tile &tile )
   tile.setFlag( Tile::tlMeadow, saveMeadow);
 }
 
-void Building::timeStep(const unsigned long time)
+void Building::build( CityPtr city, const TilePos& pos )
 {
-   if (time % 64 == 0)
-   {
-      updateState( Construction::damage, _damageIncrement );
-      updateState( Construction::fire, _fireIncrement );
-   }
+  Construction::build( city, pos );
+
+  if( _damageIncrement != 0 || _fireIncrement != 0 )
+  {
+    _addPeriodic( 64, this, &Building::_updateDecay );
+  }
+}
 
+void Building::timeStep(const unsigned long time)
+{
    Construction::timeStep(time);
 }
 
+void Building::_updateDecay()
+{
+  updateState( Construction::damage, _damageIncrement );
+  updateState( Construction::fire, _fireIncrement );
+}
+
 void Building::storeGoods(GoodStock &stock, const int amount)
 {
    _OC3_DEBUG_BREAK_IF("This building should not store any goods");
@@ -220,9 +230,16 @@ Dock::Dock() : Building( building::B_DOCK, Size(2) )
   
   _getAnimation().setOffset( Point( 107, 61 ) );
   _getFgPictures().resize(1);
+
+  _damageIncrement = 0;
+  _fireIncrement = 0;
 }
 
 void Dock::timeStep(const unsigned long time)
+{
+}
+
+void Dock::animate( unsigned int time )
 {
   _getAnimation().update( time );
   
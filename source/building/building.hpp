@@ -41,6 +41,7 @@ public:
   Building(const Type type, const Size& size=Size(1) );
   virtual void initTerrain(Tile& terrain);
 
+  virtual void build( CityPtr city, const TilePos& pos );
   virtual void timeStep(const unsigned long time);
   virtual void storeGoods(GoodStock &stock, const int amount = -1);
   // evaluate the given service
@@ -56,6 +57,9 @@ public:
   void applyTrainee( constants::walker::Type traineeType); // trainee arrives
 
 protected:
+  // called once in 64 ticks, building takes damage and fire risk
+  virtual void _updateDecay();
+
   float _damageIncrement;
   float _fireIncrement;
   typedef std::map< constants::walker::Type, int> TraineeMap;
@@ -102,6 +106,7 @@ class Dock : public Building
 public:
   Dock();
   void timeStep(const unsigned long time);
+  void animate( unsigned int time );
 };
 
 #endif
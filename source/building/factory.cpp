@@ -156,15 +156,6 @@ void Factory::timeStep(const unsigned long time)
      if( _d->produceGood )
      {
        _d->progress += work;
-
-       _getAnimation().update( time );
-       const Picture& pic = _getAnimation().getFrame();
-       if( pic.isValid() )
-       {
-         // animation of the working factory
-         int level = _getFgPictures().size()-1;
-         _getFgPictures().at(level) = _getAnimation().getFrame();
-       }
      }
    }  
 
@@ -184,6 +175,23 @@ void Factory::timeStep(const unsigned long time)
    }
 }
 
+void Factory::animate( unsigned int time )
+{
+  // animation of the working factory
+  if( !mayWork() || !_d->produceGood )
+  {
+    return;
+  }
+
+  _getAnimation().update( time );
+  const Picture& pic = _getAnimation().getFrame();
+  if( pic.isValid() )
+  {
+    int level = _getFgPictures().size()-1;
+    _getFgPictures().at(level) = _getAnimation().getFrame();
+  }
+}
+
 void Factory::deliverGood()
 {
   // make a cart pusher and send him away
@@ -54,6 +54,7 @@ public:
   virtual bool standIdle() const;
 
   virtual void timeStep(const unsigned long time);
+  virtual void animate( unsigned int time );
 
   virtual void save( VariantMap& stream) const;
   virtual void load( const VariantMap& stream);
@@ -16,6 +16,7 @@
 #include "granary.hpp"
 #include "game/resourcegroup.hpp"
 #include "gfx/picture.hpp"
+#include "gfx/picture_bank.hpp"
 #include "core/variant.hpp"
 #include "walker/cart_pusher.hpp"
 #include "game/goodstore_simple.hpp"
@@ -108,10 +109,6 @@ void Granary::timeStep(const unsigned long time)
   WorkingBuilding::timeStep( time );
   if( getWorkers() > 0 )
   {
-    _getAnimation().update( time );
-
-    _getFgPictures().at(5) = _getAnimation().getFrame();
-
     if( time % 22 == 1 && _d->goodStore.isDevastation() 
         && (_d->goodStore.getCurrentQty() > 0) && getWalkerList().empty() )
     {
@@ -120,6 +117,16 @@ void Granary::timeStep(const unsigned long time)
   }
 }
 
+void Granary::animate( unsigned int time )
+{
+  if( getWorkers() > 0 )
+  {
+    _getAnimation().update( time );
+
+    _getFgPictures().at(5) = _getAnimation().getFrame();
+  }
+}
+
 GoodStore& Granary::getGoodStore()
 {
   return _d->goodStore;
@@ -127,6 +134,11 @@ GoodStore& Granary::getGoodStore()
 
 void Granary::computePictures()
 {
+  static const PictureHandle windows[] = { PictureHandle( ResourceGroup::commerce, 142 ),
+                                           PictureHandle( ResourceGroup::commerce, 143 ),
+                                           PictureHandle( ResourceGroup::commerce, 144 ),
+                                           PictureHandle( ResourceGroup::commerce, 145 ) };
+
   int allQty = _d->goodStore.getCurrentQty();
   int maxQty = _d->goodStore.getMaxQty();
 
@@ -138,19 +150,19 @@ void Granary::computePictures()
 
   if (allQty > 0)
   {
-    _getFgPictures().at(1) = Picture::load( ResourceGroup::commerce, 142);
+    _getFgPictures().at(1) = windows[ 0 ];
   }
   if( allQty > maxQty * 0.25)
   {
-    _getFgPictures().at(2) = Picture::load( ResourceGroup::commerce, 143);
+    _getFgPictures().at(2) = windows[ 1 ];
   }
   if (allQty > maxQty * 0.5)
   {
-    _getFgPictures().at(3) = Picture::load( ResourceGroup::commerce, 144);
+    _getFgPictures().at(3) = windows[ 2 ];
   }
   if (allQty > maxQty * 0.9)
   {
-    _getFgPictures().at(4) = Picture::load( ResourceGroup::commerce, 145);
+    _getFgPictures().at(4) = windows[ 3 ];
   }
 }
 
@@ -25,6 +25,7 @@ public:
   Granary();
 
   virtual void timeStep(const unsigned long time);
+  virtual void animate( unsigned int time );
   void computePictures();
   GoodStore& getGoodStore();
 
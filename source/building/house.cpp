@@ -25,20 +25,55 @@
 #include "building/market.hpp"
 #include "game/tileoverlay_factory.hpp"
 #include "game/resourcegroup.hpp"
+#include "gfx/picture_bank.hpp"
 #include "core/variant.hpp"
 #include "game/empire.hpp"
 #include "game/tilemap.hpp"
 #include "game/gamedate.hpp"
 #include "game/goodstore_simple.hpp"
 #include "game/city.hpp"
+#include "game/cityservice_vacancies.hpp"
 #include "core/foreach.hpp"
 #include "constants.hpp"
 #include "events/event.hpp"
 
+namespace
+{
+
+SmartPtr< CityServiceVacancies > getVacancies( CityPtr city )
+{
+  if( city.isNull() )
+    return SmartPtr< CityServiceVacancies >();
+
+  return city->findService( CityServiceVacancies::getDefaultName() ).as<CityServiceVacancies>();
+}
+
+}
+
 class House::Impl
 {
 public:
-  typedef std::map< Service::Type, Service > Services;
+  // dense storage indexed by service type, lookups are plain array access
+  class Services
+  {
+  public:
+    Service& operator[]( Service::Type type ) { return _items[ type ]; }
+    const Service& operator[]( Service::Type type ) const { return _items[ type ]; }
+
+    void consume( Service::Type keep )
+    {
+      const int keepValue = _items[ keep ];
+      for( int i=0; i < Service::srvCount; i++ )
+      {
+        _items[ i ] -= 1;
+      }
+      _items[ keep ] = keepValue;
+    }
+
+  private:
+    Service _items[ Service::srvCount ];
+  };
+
   int picIdOffset;
   int houseId;  // pictureId
   int houseLevel;
@@ -92,9 +127,7 @@ public:
 
   void consumeServices()
   {
-    int currentWorkersPower = services[ Service::workersRecruter ];       //save available workers number
-    foreach( Services::value_type& srvc, services ) { srvc.second -= 1; } //consume services
-    services[ Service::workersRecruter ] = currentWorkersPower;     //restore available workers number
+    services.consume( Service::workersRecruter ); //available workers number isn't consumed
   }
 
   void makeOldHabitants()
@@ -150,50 +183,66 @@ void House::timeStep(const unsigned long time)
   {
     _d->currentYear = GameDate::current().getYear();
     _d->makeOldHabitants();
+    _updateVacancy();
   }
 
-  if( time % 16 == 0 )
-  {
-    _d->consumeServices();
-    _d->updateHealthLevel();
+  Building::timeStep( time );
+}
 
-    appendServiceValue( Service::crime, _d->spec.getCrime() + 1 );
-  }
+void House::_updateServices()
+{
+  if( _d->habitants.empty()  )
+    return;
+
+  _d->consumeServices();
+  _d->updateHealthLevel();
+
+  appendServiceValue( Service::crime, _d->spec.getCrime() + 1 );
+}
 
-  if( time % 64 == 0 )
+void House::_updateLevel()
+{
+  if( _d->habitants.empty()  )
+    return;
+
+  // consume goods
+  for( int i = 0; i < Good::goodCount; ++i)
   {
-    // consume goods
-    for( int i = 0; i < Good::goodCount; ++i)
-    {
-       Good::Type goodType = (Good::Type) i;
-       int montlyGoodsQty = _d->spec.computeMonthlyConsumption( *this, goodType, true );
-       _d->goodStore.setCurrentQty( goodType, std::max( _d->goodStore.getCurrentQty(goodType) - montlyGoodsQty, 0) );
-    }
+     Good::Type goodType = (Good::Type) i;
+     int montlyGoodsQty = _d->spec.computeMonthlyConsumption( *this, goodType, true );
+     _d->goodStore.setCurrentQty( goodType, std::max( _d->goodStore.getCurrentQty(goodType) - montlyGoodsQty, 0) );
+  }
 
-    bool validate = _d->spec.checkHouse( this );
-    if( !validate )
-    {
-      levelDown();
-    }
-    else
+  bool validate = _d->spec.checkHouse( this );
+  if( !validate )
+  {
+    levelDown();
+  }
+  else
+  {
+    _d->condition4Up = "";
+    if( _d->spec.next().checkHouse( this, &_d->condition4Up ) )
     {
-      _d->condition4Up = "";
-      if( _d->spec.next().checkHouse( this, &_d->condition4Up ) )
-      {
-         levelUp();
-      }
+       levelUp();
     }
+  }
 
-    int homelessCount = math::clamp( _d->habitants.count() - _d->maxHabitants, 0, 0xff );
-    if( homelessCount > 0 )
-    {
-      CitizenGroup homeless = _d->habitants.retrieve( homelessCount );
+  int homelessCount = math::clamp( _d->habitants.count() - _d->maxHabitants, 0, 0xff );
+  if( homelessCount > 0 )
+  {
+    CitizenGroup homeless = _d->habitants.retrieve( homelessCount, _getCity()->getRandom() );
 
-      Immigrant::send2City( _getCity(), homeless, getTile() );
-    }
+    Immigrant::send2City( _getCity(), homeless, getTile() );
   }
+}
 
-  Building::timeStep( time );
+void House::_updateDecay()
+{
+  // empty house does not decay
+  if( _d->habitants.empty()  )
+    return;
+
+  Building::_updateDecay();
 }
 
 GoodStore& House::getGoodStore()
@@ -378,7 +427,7 @@ void House::levelDown()
        foreach( Tile* tile, perimetr )
        {
          HousePtr house = TileOverlayFactory::getInstance().create( constants::building::house ).as<House>();
-         house->_d->habitants = _d->habitants.retrieve( peoplesPerHouse );
+         house->_d->habitants = _d->habitants.retrieve( peoplesPerHouse, _getCity()->getRandom() );
          house->_d->houseId = smallHovel;
          house->_update();
 
@@ -615,11 +664,32 @@ int House::getMaxHabitants()
 void House::_update()
 {
   int picId = ( _d->houseId == smallHovel && _d->habitants.count() == 0 ) ? 45 : (_d->houseId + _d->picIdOffset);
-  Picture pic = Picture::load( ResourceGroup::housing, picId );
+  static const unsigned int housingGroupId = PictureBank::instance().getGroupId( ResourceGroup::housing );
+  const Picture& pic = PictureBank::instance().getPicture( housingGroupId, picId );
   setPicture( pic );
   setSize( Size( (pic.getWidth() + 2 ) / 60 ) );
   _d->maxHabitants = _d->spec.getMaxHabitantsByTile() * getSize().getArea();
   _d->initGoodStore( getSize().getArea() );
+  _updateVacancy();
+}
+
+void House::_updateVacancy()
+{
+  SmartPtr< CityServiceVacancies > vacancies = getVacancies( _getCity() );
+  if( vacancies.isValid() )
+  {
+    vacancies->updateHouse( this );
+  }
+}
+
+void House::build( CityPtr city, const TilePos& pos )
+{
+  Building::build( city, pos );
+
+  _addPeriodic( 16, this, &House::_updateServices );
+  _addPeriodic( 64, this, &House::_updateLevel );
+
+  _updateVacancy();
 }
 
 int House::getRoadAccessDistance() const
@@ -630,7 +700,7 @@ int House::getRoadAccessDistance() const
 void House::addHabitants( CitizenGroup& habitants )
 {
   int peoplesCount = math::clamp(  _d->maxHabitants - _d->habitants.count(), 0, _d->maxHabitants );
-  CitizenGroup newHabitants = habitants.retrieve( peoplesCount );
+  CitizenGroup newHabitants = habitants.retrieve( peoplesCount, _getCity()->getRandom() );
   _d->habitants += newHabitants;
   _d->services[ Service::workersRecruter ].setMax( _d->habitants.count( CitizenGroup::mature ) );
   _d->services[ Service::workersRecruter ] += newHabitants.count( CitizenGroup::mature );
@@ -650,6 +720,12 @@ void House::destroy()
 
   _d->habitants.clear();
 
+  SmartPtr< CityServiceVacancies > vacancies = getVacancies( _getCity() );
+  if( vacancies.isValid() )
+  {
+    vacancies->removeHouse( this );
+  }
+
   Building::destroy();
 }
 
@@ -677,10 +753,10 @@ void House::save( VariantMap& stream ) const
   stream[ "healthLevel" ] = _d->healthLevel;
 
   VariantList vl_services;
-  foreach( Impl::Services::value_type& mapItem, _d->services )
+  for( int i=0; i < Service::srvCount; i++ )
   {
-    vl_services.push_back( Variant( (int)mapItem.first) );
-    vl_services.push_back( Variant( mapItem.second ) );
+    vl_services.push_back( Variant( i ) );
+    vl_services.push_back( Variant( _d->services[ Service::Type( i ) ].value() ) );
   }
 
   stream[ "services" ] = vl_services;
@@ -712,9 +788,15 @@ void House::load( const VariantMap& stream )
   {
     Service::Type type = Service::Type( (*it).toInt() );
     it++;
+    if( it == vl_services.end() )
+      break;
+
     int serviceValue = (*it).toInt();
 
-    _d->services[ type ] = serviceValue;
+    if( type >= 0 && type < Service::srvCount )
+    {
+      _d->services[ type ] = serviceValue;
+    }
   }
 
   Building::build( _getCity(), getTilePos() );
@@ -34,6 +34,7 @@ public:
   House( const int houseId=smallHovel );
 
   virtual void timeStep(const unsigned long time);
+  virtual void build( CityPtr city, const TilePos& pos );
 
   virtual GoodStore& getGoodStore();
 
@@ -78,9 +79,15 @@ public:
 
   bool isWalkable() const;
 
+protected:
+  virtual void _updateDecay();
+
 private:
 
   void _update();
+  void _updateVacancy();
+  void _updateServices();
+  void _updateLevel();
   void _tryUpdate_1_to_11_lvl( int level, int startSmallPic, int startBigPic, const char desirability );
   void _tryDegrage_11_to_2_lvl( int smallPic, int bigPic, const char desirability );
 
@@ -139,6 +139,9 @@ void BurnedRuins::timeStep( const unsigned long time )
 BurnedRuins::BurnedRuins() : Building( building::B_BURNED_RUINS, Size(1) )
 {
   setPicture( ResourceGroup::land2a, 111 + rand() % 8 );
+
+  _damageIncrement = 0;
+  _fireIncrement = 0;
 }
 
 void BurnedRuins::build( CityPtr city, const TilePos& pos )
@@ -204,6 +207,8 @@ bool CollapsedRuins::isNeedRoadAccess() const
 PlagueRuins::PlagueRuins() : Building( building::B_PLAGUE_RUINS, Size(1) )
 {
   updateState( Construction::fire, 99, false );
+  _damageIncrement = 0;
+  _fireIncrement = 0;
 
   setPicture( ResourceGroup::land2a, 187 );
   _getAnimation().load( ResourceGroup::land2a, 188, 8 );
@@ -215,9 +220,6 @@ PlagueRuins::PlagueRuins() : Building( building::B_PLAGUE_RUINS, Size(1) )
 
 void PlagueRuins::timeStep(const unsigned long time)
 {
-  _getAnimation().update( time );
-  _getFgPictures().at( 0 ) = _getAnimation().getFrame();
-
   if (time % 16 == 0 )
   {
     if( getState( Construction::fire ) > 0 )
@@ -260,6 +262,12 @@ void PlagueRuins::applyService(ServiceWalkerPtr walker)
 
 }
 
+void PlagueRuins::animate( unsigned int time )
+{
+  _getAnimation().update( time );
+  _getFgPictures().at( 0 ) = _getAnimation().getFrame();
+}
+
 void PlagueRuins::burn()
 {
 
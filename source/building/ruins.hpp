@@ -67,6 +67,7 @@ public:
   PlagueRuins();
 
   void timeStep(const unsigned long time);
+  void animate( unsigned int time );
   void burn();
   void build( CityPtr city, const TilePos& pos );
   bool isWalkable() const;
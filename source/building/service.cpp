@@ -73,7 +73,10 @@ void ServiceBuilding::timeStep(const unsigned long time)
    {
       _d->serviceTimer -= 1;
    }
+}
 
+void ServiceBuilding::animate( unsigned int time )
+{
    _getAnimation().update( time );
    const Picture& pic = _getAnimation().getFrame();
    if( pic.isValid() )
@@ -34,6 +34,7 @@ public:
 
   Service::Type getService() const;
   virtual void timeStep(const unsigned long time);
+  virtual void animate( unsigned int time );
   virtual void destroy();  // handles the walkers
 
   int getServiceRange() const;  // max distance from building to road for road to propose the service
@@ -53,6 +53,14 @@ void TrainingBuilding::timeStep(const unsigned long time)
    {
       _trainingTimer -= 1;
    }
+}
+
+void TrainingBuilding::animate( unsigned int time )
+{
+   if( getWorkers() <= 0 )
+   {
+     return;
+   }
 
    _getAnimation().update( time );
    const Picture& pic = _getAnimation().getFrame();
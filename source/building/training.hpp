@@ -27,6 +27,7 @@ public:
    TrainingBuilding(const TileOverlay::Type type, const Size& size);
 
    virtual void timeStep(const unsigned long time);
+   virtual void animate( unsigned int time );
 
    // called when a trainee is created
    virtual void deliverTrainee() = 0;
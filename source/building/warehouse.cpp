@@ -20,6 +20,7 @@
 #include <iostream>
 
 #include "gfx/picture.hpp"
+#include "gfx/picture_bank.hpp"
 #include "core/exception.hpp"
 #include "gui/info_box.hpp"
 #include "core/gettext.hpp"
@@ -84,7 +85,8 @@ void WarehouseTile::computePicture()
     picIdx += _stock._currentQty/100 -1;
   }
 
-  _picture = Picture::load( ResourceGroup::warehouse, picIdx );
+  static const unsigned int warehouseGroupId = PictureBank::instance().getGroupId( ResourceGroup::warehouse );
+  _picture = PictureBank::instance().getPicture( warehouseGroupId, picIdx );
   _picture.addOffset(30*(_pos.getI()+_pos.getJ()), 15*(_pos.getJ()-_pos.getI()));
 }
 
@@ -347,6 +349,9 @@ Warehouse::Warehouse() : WorkingBuilding( constants::building::warehouse, Size(
   setPicture( ResourceGroup::warehouse, 19 );
   _getFgPictures().resize(12);  // 8 tiles + 4
 
+  _damageIncrement = 0;
+  _fireIncrement = 0;
+
   _getAnimation().load( ResourceGroup::warehouse, 2, 16 );
   _getAnimation().setDelay( 4 );
 
@@ -373,7 +378,7 @@ Warehouse::Warehouse() : WorkingBuilding( constants::building::warehouse, Size(
   computePictures();
 }
 
-void Warehouse::timeStep(const unsigned long time)
+void Warehouse::animate( unsigned int time )
 {
   if( getWorkers() > 0 )
   {
@@ -383,7 +388,10 @@ void Warehouse::timeStep(const unsigned long time)
    _getFgPictures().at(2) = _getAnimation().getFrame();
    _getFgPictures().at(3) = _d->animFlag.getFrame();
   }
+}
 
+void Warehouse::timeStep(const unsigned long time)
+{
   if( _d->goodStore.isDevastation() && (time % 22 == 1 ) )
   {
     _resolveDevastationMode();
@@ -34,6 +34,7 @@ public:
   Warehouse();
 
   virtual void timeStep(const unsigned long time);
+  virtual void animate( unsigned int time );
   void computePictures();
   GoodStore& getGoodStore();
   
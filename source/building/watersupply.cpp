@@ -28,6 +28,7 @@
 #include "core/gettext.hpp"
 #include "game/tilemap.hpp"
 #include "core/logger.hpp"
+#include "game/cityservice_water.hpp"
 #include "constants.hpp"
 
 using namespace constants;
@@ -35,14 +36,8 @@ using namespace constants;
 class WaterSource::Impl
 {
 public:
-  typedef std::map< int, int > WaterSourceMap;
-  WaterSourceMap sourcesMap;
-  WaterSourceMap consumersMap;
-
   int  water;
-  bool lastWaterState;
   bool isRoad;
-  bool alsoResolved;
   std::string errorStr;
 };
 
@@ -50,7 +45,6 @@ Aqueduct::Aqueduct() : WaterSource( building::B_AQUEDUCT, Size(1) )
 {
   setPicture( ResourceGroup::aqueduct, 133 ); // default picture for aqueduct
   _d->isRoad = false;
-  _d->alsoResolved = false;
   // land2a 119 120         - aqueduct over road
   // land2a 121 122         - aqueduct over plain ground
   // land2a 123 124 125 126 - aqueduct corner
@@ -82,11 +76,13 @@ void Aqueduct::build( CityPtr city, const TilePos& pos )
   }
 
   updatePicture( city );
+  _joinNetwork();
 }
 
 void Aqueduct::destroy()
 {
   Construction::destroy();
+  _leaveNetwork();
 
   if( _getCity().isValid() )
   {
@@ -324,17 +320,10 @@ void Aqueduct::_waterStateChanged()
   updatePicture( _getCity() );
 }
 
-void Aqueduct::addWater( const WaterSource& source )
+WaterSourceList Aqueduct::getOutlets() const
 {
-  if( !_d->alsoResolved )
-  {
-    _d->alsoResolved = true;
-    WaterSource::addWater( source );
-
-    const TilePos offsets[4] = { TilePos( -1, 0 ), TilePos( 0, 1), TilePos( 1, 0), TilePos( 0, -1) };
-    _produceWater( offsets, 4 );
-    _d->alsoResolved = false;
-  }
+  const TilePos offsets[4] = { TilePos( -1, 0 ), TilePos( 0, 1), TilePos( 1, 0), TilePos( 0, -1) };
+  return _findSources( offsets, 4 );
 }
 
 bool Aqueduct::isWalkable() const
@@ -360,6 +349,7 @@ void Reservoir::destroy()
 
   // update adjacent aqueducts
   Construction::destroy();
+  _leaveNetwork();
 }
 
 Reservoir::Reservoir() : WaterSource( building::B_RESERVOIR, Size( 3 ) )
@@ -388,10 +378,22 @@ void Reservoir::build( CityPtr city, const TilePos& pos )
 
   setPicture( ResourceGroup::waterbuildings, 1 );
   _isWaterSource = _isNearWater( city, pos );
-  
-  //updateAqueducts();
+
+  _addPeriodic( 22, this, &Reservoir::_fillWaterArea );
   
   // update adjacent aqueducts
+  _joinNetwork();
+}
+
+bool Reservoir::isNearWater() const
+{
+  return _isWaterSource;
+}
+
+WaterSourceList Reservoir::getOutlets() const
+{
+  const TilePos offsets[4] = { TilePos( -1, 1), TilePos( 1, 3 ), TilePos( 3, 1), TilePos( 1, -1) };
+  return _findSources( offsets, 4 );
 }
 
 bool Reservoir::_isNearWater(CityPtr city, const TilePos& pos ) const
@@ -420,33 +422,31 @@ void Reservoir::timeStep(const unsigned long time)
 {
   WaterSource::timeStep( time );
 
-  if( _isWaterSource )
+  if( !_d->water )
   {
-    _d->water = 16;
+    _getFgPictures().at( 0 ) = Picture::getInvalid();
   }
+}
 
+void Reservoir::_fillWaterArea()
+{
   if( !_d->water )
-  {
-    _getFgPictures().at( 0 ) = Picture::getInvalid();
     return;
-  }
 
   //filled area, that reservoir present
-  if( time % 22 == 1 )
+  Tilemap& tmap = _getCity()->getTilemap();
+  TilemapArea reachedTiles = tmap.getArea( getTilePos() - TilePos( 10, 10 ), Size( 10 + 10 ) + getSize() );
+  foreach( Tile* tile, reachedTiles )
   {
-    Tilemap& tmap = _getCity()->getTilemap();
-    TilemapArea reachedTiles = tmap.getArea( getTilePos() - TilePos( 10, 10 ), Size( 10 + 10 ) + getSize() );
-    foreach( Tile* tile, reachedTiles )
-    {
-      tile->fillWaterService( WTR_RESERVOIR );
-    }   
+    tile->fillWaterService( WTR_RESERVOIR );
   }
+}
 
-  //add water to all consumer
-  if( time % 11 == 1 )
+void Reservoir::animate( unsigned int time )
+{
+  if( !_d->water )
   {
-    const TilePos offsets[4] = { TilePos( -1, 1), TilePos( 1, 3 ), TilePos( 3, 1), TilePos( 1, -1) };  
-    _produceWater(offsets, 4);
+    return;
   }
 
   _getAnimation().update( time );
@@ -477,14 +477,6 @@ WaterSource::WaterSource(const Type type, const Size& size )
 
 {
   _d->water = 0;
-  _d->lastWaterState = false;
-}
-
-void WaterSource::addWater( const WaterSource& source )
-{
-  _d->water = math::clamp( _d->water+1, 0, 16 );
-  int sourceId = source.getId();
-  _d->sourcesMap[ sourceId ] = math::clamp( _d->sourcesMap[ sourceId ]+1, 0, 4 );
 }
 
 bool WaterSource::haveWater() const
@@ -492,28 +484,44 @@ bool WaterSource::haveWater() const
   return _d->water > 0;
 } 
 
-void WaterSource::timeStep( const unsigned long time )
+void WaterSource::setHaveWater( bool value )
 {
-  if( time % 22 == 1)
+  bool lastState = haveWater();
+  _d->water = value ? 16 : 0;
+
+  if( lastState != value )
   {
-    _d->water = math::clamp( _d->water-1, 0, 16 );
-    if( _d->lastWaterState != (_d->water > 0) )
-    {
-      _d->lastWaterState = _d->water > 0;
-      _waterStateChanged();
-    }
+    _waterStateChanged();
+  }
+}
 
-    foreach( Impl::WaterSourceMap::value_type& item, _d->sourcesMap )
-    {
-      item.second = math::clamp( item.second-1, 0, 4 );
-    }
+void WaterSource::_joinNetwork()
+{
+  if( _getCity().isNull() )
+    return;
+
+  SmartPtr< CityServiceWater > network = _getCity()->findService( CityServiceWater::getDefaultName() ).as<CityServiceWater>();
+  if( network.isValid() )
+  {
+    network->addSource( WaterSourcePtr( this ) );
   }
+}
 
-  Construction::timeStep( time );
+void WaterSource::_leaveNetwork()
+{
+  if( _getCity().isNull() )
+    return;
+
+  SmartPtr< CityServiceWater > network = _getCity()->findService( CityServiceWater::getDefaultName() ).as<CityServiceWater>();
+  if( network.isValid() )
+  {
+    network->removeSource( WaterSourcePtr( this ) );
+  }
 }
 
-void WaterSource::_produceWater( const TilePos* points, const int size )
+WaterSourceList WaterSource::_findSources( const TilePos* points, const int size ) const
 {
+  WaterSourceList ret;
   Tilemap& tilemap = _getCity()->getTilemap();
 
   for( int index=0; index < size; index++ )
@@ -524,16 +532,14 @@ void WaterSource::_produceWater( const TilePos* points, const int size )
       continue;
     }
 
-    SmartPtr< WaterSource > ws = tilemap.at( pos ).getOverlay().as<WaterSource>();
-    
+    WaterSourcePtr ws = tilemap.at( pos ).getOverlay().as<WaterSource>();
     if( ws.isValid() )
-    {     
-      if( _d->sourcesMap[ ws->getId() ] == 0 )
-      {
-        ws->addWater( *this );
-      }
+    {
+      ret.push_back( ws );
     }
   }
+
+  return ret;
 }
 
 int WaterSource::getId() const
@@ -580,44 +586,39 @@ void Fountain::deliverService()
   } 
 }
 
-void Fountain::timeStep(const unsigned long time)
+void Fountain::_updateWater()
 {
   //filled area, that fontain present and work
-  if( time % 22 == 1 )
+  if( getTile().getWaterService( WTR_RESERVOIR ) > 0 && getWorkers() > 0 )
   {
-    if( getTile().getWaterService( WTR_RESERVOIR ) > 0 && getWorkers() > 0 )
-    {
-      _haveReservoirWater = true;
-      _getAnimation().start();
-    }
-    else
-    {
-      //remove fontain service from tiles
-      Tilemap& tmap = _getCity()->getTilemap();
-      TilemapArea reachedTiles = tmap.getArea( getTilePos() - TilePos( 4, 4 ), Size( 4 + 4 ) + getSize() );
-      foreach( Tile* tile, reachedTiles )
-      {
-        tile->decreaseWaterService( WTR_FONTAIN );
-      }
-
-      _getAnimation().stop();
-    }
-
-    if( !isActive() )
-    {
-      _getFgPictures().at( 0 ) = Picture::getInvalid();
-      return;
-    }
-
+    _haveReservoirWater = true;
+    _getAnimation().start();
+  }
+  else
+  {
+    //remove fontain service from tiles
     Tilemap& tmap = _getCity()->getTilemap();
     TilemapArea reachedTiles = tmap.getArea( getTilePos() - TilePos( 4, 4 ), Size( 4 + 4 ) + getSize() );
     foreach( Tile* tile, reachedTiles )
     {
-      tile->fillWaterService( WTR_FONTAIN );
+      tile->decreaseWaterService( WTR_FONTAIN );
     }
+
+    _getAnimation().stop();
   }
 
-  ServiceBuilding::timeStep( time );
+  if( !isActive() )
+  {
+    _getFgPictures().at( 0 ) = Picture::getInvalid();
+    return;
+  }
+
+  Tilemap& tmap = _getCity()->getTilemap();
+  TilemapArea reachedTiles = tmap.getArea( getTilePos() - TilePos( 4, 4 ), Size( 4 + 4 ) + getSize() );
+  foreach( Tile* tile, reachedTiles )
+  {
+    tile->fillWaterService( WTR_FONTAIN );
+  }
 }
 
 bool Fountain::canBuild( CityPtr city, const TilePos& pos ) const
@@ -637,6 +638,7 @@ void Fountain::build( CityPtr city, const TilePos& pos )
   ServiceBuilding::build( city, pos );
 
   setPicture( ResourceGroup::waterbuildings, fontainEmpty );
+  _addPeriodic( 22, this, &Fountain::_updateWater );
 }
 
 bool Fountain::isNeedRoadAccess() const
@@ -669,7 +671,7 @@ void Fountain::load(const VariantMap& stream)
   ServiceBuilding::load( stream );
 
   //check animation
-  timeStep( 1 );
+  _updateWater();
 }
 
 void Fountain::_initAnimation()
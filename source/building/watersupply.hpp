@@ -28,24 +28,26 @@ class WaterSource : public Construction
 public:
   WaterSource( const TileOverlay::Type type, const Size& size );
   
-  virtual void addWater( const WaterSource& source );
   virtual bool haveWater() const;
-  virtual void timeStep(const unsigned long time);
+  void setHaveWater( bool value );
   int getId() const;
 
+  // sources which take water from this one
+  virtual WaterSourceList getOutlets() const = 0;
+
   virtual std::string getError() const;
 
 protected:
   void _setError( const std::string& error );
   virtual void _waterStateChanged() {}
-  virtual void _produceWater( const TilePos* points, const int size );
+  void _joinNetwork();
+  void _leaveNetwork();
+  WaterSourceList _findSources( const TilePos* points, const int size ) const;
   
   class Impl;
   ScopedPtr< Impl > _d;
 };
 
-
-
 class Aqueduct : public WaterSource
 {
 public:
@@ -63,7 +65,7 @@ public:
   virtual bool isRoad() const;
 
   void updatePicture(CityPtr city);
-  void addWater( const WaterSource& source );
+  virtual WaterSourceList getOutlets() const;
 
 protected:
   virtual void _waterStateChanged();
@@ -80,11 +82,17 @@ public:
   virtual bool isNeedRoadAccess() const;
   virtual void initTerrain(Tile& terrain);
   virtual void timeStep(const unsigned long time);
+  virtual void animate( unsigned int time );
   virtual void destroy();
+  virtual WaterSourceList getOutlets() const;
+
+  // reservoir near water fills whole network
+  bool isNearWater() const;
 
 private:
   bool _isWaterSource;
   bool _isNearWater( CityPtr city, const TilePos& pos ) const;
+  void _fillWaterArea();
 };
 
 class Fountain : public ServiceBuilding
@@ -95,7 +103,6 @@ public:
   virtual void build( CityPtr city, const TilePos& pos );
   virtual bool canBuild(CityPtr city, const TilePos& pos ) const;
   virtual void deliverService();
-  virtual void timeStep(const unsigned long time);
   virtual bool isNeedRoadAccess() const;
 
   virtual bool isActive() const;
@@ -105,6 +112,7 @@ public:
 private:
   bool _haveReservoirWater;
   void _initAnimation();
+  void _updateWater();
 };
 
 #endif // __OPENCAESAR3_WATER_BUILDGINDS_INCLUDED__
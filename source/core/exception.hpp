@@ -21,8 +21,10 @@
 
 
 #include <sstream>
+#include "logger.hpp"
 
-#define THROW(x)   { std::stringstream _exception_text; _exception_text << x; throw Exception(_exception_text.str()); }
+// buffered log is written out first, it tells what happened before exception
+#define THROW(x)   { Logger::flush(); std::stringstream _exception_text; _exception_text << x; throw Exception(_exception_text.str()); }
 
 
 class Exception
@@ -16,6 +16,7 @@
 #include "logger.hpp"
 #include "requirements.hpp"
 #include "stringhelper.hpp"
+#include "time.hpp"
 
 #include <cstdarg>
 #include <cfloat>
@@ -26,25 +27,229 @@
 #include <iostream>
 #include <stdint.h>
 #include <fstream>
+#include <cstdlib>
+
+namespace {
+
+class LogWriter
+{
+public:
+  enum { maxBufferSize=16384, flushInterval=500 };
+
+  Logger::Level level;
+  unsigned int categories;
+  std::string buffer;
+  unsigned int lastFlush;
+
+  LogWriter() : level( Logger::lvInfo ), categories( Logger::catAll ), lastFlush( 0 ) {}
+
+  void write( Logger::Level msgLevel, const std::string& text )
+  {
+    buffer.append( text );
+    buffer.append( 1, '\n' );
+
+    if( msgLevel >= Logger::lvError || buffer.size() > maxBufferSize )
+    {
+      flush();
+    }
+    else
+    {
+      update();
+    }
+  }
+
+  void update()
+  {
+    if( DateTime::getElapsedTime() - lastFlush > flushInterval )
+    {
+      flush();
+    }
+  }
+
+  void flush()
+  {
+    lastFlush = DateTime::getElapsedTime();
+    if( buffer.empty() )
+      return;
+
+    std::cout.write( buffer.data(), buffer.size() );
+    std::cout.flush();
+    buffer.clear();
+  }
+};
+
+void flushAtExit();
+
+// writer is never destroyed, so messages from destructors of other
+// static objects still have somewhere to go
+LogWriter& writer()
+{
+  static LogWriter* inst = 0;
+  if( inst == 0 )
+  {
+    inst = new LogWriter();
+    atexit( flushAtExit );
+  }
+
+  return *inst;
+}
+
+void flushAtExit()
+{
+  writer().flush();
+}
+
+void vwrite( Logger::Level level, const char* fmt, va_list argument_list )
+{
+  std::string ret;
+  StringHelper::vformat( ret, 512, fmt, argument_list );
+
+  writer().write( level, ret );
+}
+
+}
+
+void Logger::debug( const char* fmt, ... )
+{
+  if( !isEnabled( lvDebug ) )
+    return;
+
+  va_list argument_list;
+  va_start(argument_list, fmt);
+  vwrite( lvDebug, fmt, argument_list );
+  va_end(argument_list);
+}
+
+void Logger::debug( Category category, const char* fmt, ... )
+{
+  if( !isEnabled( lvDebug, category ) )
+    return;
+
+  va_list argument_list;
+  va_start(argument_list, fmt);
+  vwrite( lvDebug, fmt, argument_list );
+  va_end(argument_list);
+}
+
+void Logger::info( const char* fmt, ... )
+{
+  if( !isEnabled( lvInfo ) )
+    return;
+
+  va_list argument_list;
+  va_start(argument_list, fmt);
+  vwrite( lvInfo, fmt, argument_list );
+  va_end(argument_list);
+}
+
+void Logger::info( Category category, const char* fmt, ... )
+{
+  if( !isEnabled( lvInfo, category ) )
+    return;
+
+  va_list argument_list;
+  va_start(argument_list, fmt);
+  vwrite( lvInfo, fmt, argument_list );
+  va_end(argument_list);
+}
 
 void Logger::warning( const char* fmt, ... )
 {
+  if( !isEnabled( lvWarning ) )
+    return;
+
   va_list argument_list;
   va_start(argument_list, fmt);
+  vwrite( lvWarning, fmt, argument_list );
+  va_end(argument_list);
+}
 
-  std::string ret;
-  StringHelper::vformat( ret, 512, fmt, argument_list );
+void Logger::warning( Category category, const char* fmt, ... )
+{
+  if( !isEnabled( lvWarning, category ) )
+    return;
 
+  va_list argument_list;
+  va_start(argument_list, fmt);
+  vwrite( lvWarning, fmt, argument_list );
+  va_end(argument_list);
+}
+
+void Logger::error( const char* fmt, ... )
+{
+  if( !isEnabled( lvError ) )
+    return;
+
+  va_list argument_list;
+  va_start(argument_list, fmt);
+  vwrite( lvError, fmt, argument_list );
   va_end(argument_list);
+}
+
+void Logger::setLevel( Level level )
+{
+  writer().level = level;
+}
+
+void Logger::setCategories( unsigned int mask )
+{
+  writer().categories = mask;
+}
+
+bool Logger::isEnabled( Level level, Category category )
+{
+  LogWriter& w = writer();
+  return level >= w.level && (w.categories & category) != 0;
+}
+
+void Logger::flush()
+{
+  writer().flush();
+}
 
-  std::cout << ret << std::endl;
+void Logger::update()
+{
+  writer().update();
 }
 
 void Logger::redirect(std::string filename )
 {
+  flush();
+
   std::ofstream* file = new std::ofstream();
 
   file->open("stdout.txt");
   std::cout.rdbuf( file->rdbuf() ); // перенапраляем в файл
 }
 
+Logger::RateLimit::RateLimit( unsigned int intervalMs, Category category )
+  : _category( category ), _interval( intervalMs ), _lastTime( 0 ), _suppressed( 0 ), _started( false )
+{
+}
+
+void Logger::RateLimit::warning( const char* fmt, ... )
+{
+  if( !isEnabled( lvWarning, _category ) )
+    return;
+
+  unsigned int time = DateTime::getElapsedTime();
+  if( _started && time - _lastTime < _interval )
+  {
+    _suppressed++;
+    return;
+  }
+
+  if( _suppressed > 0 )
+  {
+    writer().write( lvWarning, StringHelper::format( 0xff, "(%d same messages suppressed)", _suppressed ) );
+  }
+
+  _started = true;
+  _lastTime = time;
+  _suppressed = 0;
+
+  va_list argument_list;
+  va_start(argument_list, fmt);
+  vwrite( lvWarning, fmt, argument_list );
+  va_end(argument_list);
+}
@@ -21,9 +21,61 @@
 class Logger
 {
 public:
-  static void warning( const char* fmt, ...);
+  typedef enum { lvDebug=0, lvInfo, lvWarning, lvError, lvNone } Level;
+
+  // bits of category mask, messages without category go to catGeneral
+  typedef enum { catGeneral=0x1, catBuilding=0x2, catWalker=0x4, catRoad=0x8,
+                 catTilemap=0x10, catCity=0x20, catGfx=0x40, catAll=0xffff } Category;
+
+  static void debug( const char* fmt, ... );
+  static void debug( Category category, const char* fmt, ... );
+  static void info( const char* fmt, ... );
+  static void info( Category category, const char* fmt, ... );
+  static void warning( const char* fmt, ... );
+  static void warning( Category category, const char* fmt, ... );
+
+  // written out at once, with all buffered messages before it
+  static void error( const char* fmt, ... );
+
+  // level and category are checked before message formatting
+  static void setLevel( Level level );
+  static void setCategories( unsigned int mask );
+  static bool isEnabled( Level level, Category category=catGeneral );
+
+  // output is buffered, flush happens by size/time or here,
+  // and once more at exit
+  static void flush();
+
+  // flushes output when flush interval has passed since last flush,
+  // so messages don't wait in buffer for the next one; main loop calls it
+  static void update();
 
   static void redirect( std::string filename );
+
+  // limits one call site to a message per interval:
+  //   static Logger::RateLimit limit( 1000, Logger::catBuilding );
+  //   limit.warning( "..." );
+  class RateLimit
+  {
+  public:
+    RateLimit( unsigned int intervalMs, Category category=catGeneral );
+    void warning( const char* fmt, ... );
+
+  private:
+    Category _category;
+    unsigned int _interval;
+    unsigned int _lastTime;
+    unsigned int _suppressed;
+    bool _started;
+  };
 };
 
+// debug messages are compiled in only with OC3_DEBUG_LOG,
+// otherwise arguments aren't even evaluated
+#ifdef OC3_DEBUG_LOG
+  #define OC3_DEBUG_MSG Logger::debug
+#else
+  #define OC3_DEBUG_MSG if( true ) {} else Logger::debug
+#endif
+
 #endif //__OPENCAESAR3_LOGGER_H_INCLUDED__
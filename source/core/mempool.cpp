@@ -0,0 +1,154 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "mempool.hpp"
+#include "logger.hpp"
+
+#include <new>
+#include <vector>
+
+class MemoryPool::Impl
+{
+public:
+  enum { granularity=16, maxBlockSize=512, blocksPerPage=64 };
+
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  struct Bucket
+  {
+    FreeBlock* freeList;
+    unsigned int live;
+    unsigned int peak;
+    std::vector< char* > pages;
+
+    Bucket() : freeList( 0 ), live( 0 ), peak( 0 ) {}
+  };
+
+  std::vector< Bucket > buckets; // index=size class, block size=index*granularity
+
+  static unsigned int getBucketIndex( std::size_t size )
+  {
+    return ( (size > 0 ? size : 1) + granularity - 1 ) / granularity;
+  }
+
+  void addPage( unsigned int index )
+  {
+    Bucket& bucket = buckets[ index ];
+    const std::size_t blockSize = index * granularity;
+    char* page = static_cast< char* >( ::operator new( blockSize * blocksPerPage ) );
+    bucket.pages.push_back( page );
+
+    for( int i=blocksPerPage-1; i >= 0; i-- )
+    {
+      FreeBlock* block = reinterpret_cast< FreeBlock* >( page + i * blockSize );
+      block->next = bucket.freeList;
+      bucket.freeList = block;
+    }
+  }
+};
+
+MemoryPool& MemoryPool::instance()
+{
+  // never destroyed: pooled objects may be released by other static objects on exit
+  static MemoryPool* inst = new MemoryPool();
+  return *inst;
+}
+
+void* MemoryPool::allocate( std::size_t size )
+{
+  if( size > Impl::maxBlockSize )
+  {
+    return ::operator new( size );
+  }
+
+  const unsigned int index = Impl::getBucketIndex( size );
+  Impl::Bucket& bucket = _d->buckets[ index ];
+  if( !bucket.freeList )
+  {
+    _d->addPage( index );
+  }
+
+  Impl::FreeBlock* block = bucket.freeList;
+  bucket.freeList = block->next;
+
+  bucket.live++;
+  if( bucket.live > bucket.peak )
+  {
+    bucket.peak = bucket.live;
+  }
+
+  return block;
+}
+
+void MemoryPool::deallocate( void* ptr, std::size_t size )
+{
+  if( !ptr )
+    return;
+
+  if( size > Impl::maxBlockSize )
+  {
+    ::operator delete( ptr );
+    return;
+  }
+
+  Impl::Bucket& bucket = _d->buckets[ Impl::getBucketIndex( size ) ];
+  Impl::FreeBlock* block = static_cast< Impl::FreeBlock* >( ptr );
+  block->next = bucket.freeList;
+  bucket.freeList = block;
+  bucket.live--;
+}
+
+unsigned int MemoryPool::getLiveCount( std::size_t size ) const
+{
+  return size > Impl::maxBlockSize ? 0 : _d->buckets[ Impl::getBucketIndex( size ) ].live;
+}
+
+unsigned int MemoryPool::getPeakCount( std::size_t size ) const
+{
+  return size > Impl::maxBlockSize ? 0 : _d->buckets[ Impl::getBucketIndex( size ) ].peak;
+}
+
+void MemoryPool::printStatistic() const
+{
+  for( unsigned int index=1; index < _d->buckets.size(); index++ )
+  {
+    const Impl::Bucket& bucket = _d->buckets[ index ];
+    if( bucket.peak > 0 )
+    {
+      Logger::warning( "MemoryPool: block %d bytes live %d peak %d pages %d",
+                       index * Impl::granularity, bucket.live, bucket.peak, (int)bucket.pages.size() );
+    }
+  }
+}
+
+MemoryPool::MemoryPool() : _d( new Impl )
+{
+  _d->buckets.resize( Impl::maxBlockSize / Impl::granularity + 1 );
+}
+
+MemoryPool::~MemoryPool()
+{
+  for( unsigned int index=0; index < _d->buckets.size(); index++ )
+  {
+    std::vector< char* >& pages = _d->buckets[ index ].pages;
+    for( unsigned int k=0; k < pages.size(); k++ )
+    {
+      ::operator delete( pages[ k ] );
+    }
+  }
+}
@@ -0,0 +1,54 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __OPENCAESAR3_MEMPOOL_H_INCLUDED__
+#define __OPENCAESAR3_MEMPOOL_H_INCLUDED__
+
+#include <cstddef>
+#include "core/scopedptr.hpp"
+
+//! Size-class pool for small objects which are created and destroyed often.
+/** Freed blocks are kept in per-size free lists and reused, so walkers and
+    pathways don't fragment heap in long sessions. Not thread safe. */
+class MemoryPool
+{
+public:
+  static MemoryPool& instance();
+
+  void* allocate( std::size_t size );
+  void deallocate( void* ptr, std::size_t size );
+
+  //! blocks in use for given object size
+  unsigned int getLiveCount( std::size_t size ) const;
+  unsigned int getPeakCount( std::size_t size ) const;
+
+  //! writes live/peak counters of all size classes to log
+  void printStatistic() const;
+
+  ~MemoryPool();
+
+private:
+  MemoryPool();
+
+  class Impl;
+  ScopedPtr< Impl > _d;
+};
+
+//! Routes class-specific new/delete through MemoryPool
+#define OC3_POOLED_ALLOCATION \
+  static void* operator new( std::size_t size ) { return MemoryPool::instance().allocate( size ); } \
+  static void operator delete( void* ptr, std::size_t size ) { MemoryPool::instance().deallocate( ptr, size ); }
+
+#endif //__OPENCAESAR3_MEMPOOL_H_INCLUDED__
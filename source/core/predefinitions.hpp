@@ -44,6 +44,8 @@ PREFEDINE_CLASS_SMARTPOINTER_LIST(Building,List)
 PREFEDINE_CLASS_SMARTPOINTER_LIST(Factory, List)
 PREFEDINE_CLASS_SMARTPOINTER_LIST(ServiceBuilding,List)
 PREFEDINE_CLASS_SMARTPOINTER_LIST(Aqueduct,List)
+PREFEDINE_CLASS_SMARTPOINTER_LIST(Reservoir,List)
+PREFEDINE_CLASS_SMARTPOINTER_LIST(WaterSource,List)
 PREFEDINE_CLASS_SMARTPOINTER_LIST(ActorColony,List)
 PREFEDINE_CLASS_SMARTPOINTER_LIST(GladiatorSchool,List)
 PREFEDINE_CLASS_SMARTPOINTER_LIST(Road,List)
@@ -78,6 +80,7 @@ PREFEDINE_CLASS_SMARTPOINTER(Prefecture)
 PREFEDINE_NS_CLASS_SMARTPOINTER(events,GameEvent)
 PREFEDINE_CLASS_SMARTPOINTER(Player)
 PREFEDINE_CLASS_SMARTPOINTER(Prefect)
+PREFEDINE_CLASS_SMARTPOINTER(WalkerKinematics)
 
 class Tile;
 typedef std::list< const Tile* > ConstTilemapWay;
@@ -86,6 +89,7 @@ typedef std::list< Tile* > TilemapArea;
 typedef std::list< Tile* > TilemapTiles;
 typedef std::list< const Tile* > ConstTilemapTiles;
 typedef std::list< const Tile* > ConstTilemapArea;
+typedef std::vector< Tile* > TilesArray;
 
 class VariantMap;
 class Picture;
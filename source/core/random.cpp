@@ -0,0 +1,49 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "random.hpp"
+
+namespace {
+static const unsigned int defaultSeed = 0x9e3779b9;
+}
+
+Random::Random() : _state( defaultSeed )
+{
+}
+
+void Random::setSeed( unsigned int seed )
+{
+  // xorshift never leaves zero state
+  _state = seed ? seed : defaultSeed;
+}
+
+unsigned int Random::getState() const
+{
+  return _state;
+}
+
+void Random::setState( unsigned int value )
+{
+  setSeed( value );
+}
+
+int Random::get()
+{
+  _state ^= _state << 13;
+  _state ^= _state >> 17;
+  _state ^= _state << 5;
+
+  return (int)( _state & 0x7fffffff );
+}
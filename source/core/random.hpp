@@ -0,0 +1,38 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __OPENCAESAR3_RANDOM_H_INCLUDED__
+#define __OPENCAESAR3_RANDOM_H_INCLUDED__
+
+// deterministic generator for simulation code, city owns one and saves
+// its state, so the same save and the same input give the same game
+class Random
+{
+public:
+  Random();
+
+  void setSeed( unsigned int seed );
+
+  unsigned int getState() const;
+  void setState( unsigned int state );
+
+  // non negative value, drop-in for std::rand()
+  int get();
+
+private:
+  unsigned int _state;
+};
+
+#endif //__OPENCAESAR3_RANDOM_H_INCLUDED__
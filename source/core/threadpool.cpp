@@ -0,0 +1,363 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "threadpool.hpp"
+#include "platform.hpp"
+#include "logger.hpp"
+#include "math.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#if defined(OC3_PLATFORM_WIN)
+  #include <windows.h>
+#elif defined(OC3_PLATFORM_UNIX)
+  #include <pthread.h>
+  #include <unistd.h>
+#endif
+
+namespace {
+
+// more threads give nothing on think phase of a city
+const unsigned int maxThreadsCount = 16;
+
+class Mutex
+{
+public:
+#if defined(OC3_PLATFORM_WIN)
+  Mutex() { ::InitializeCriticalSection( &_cs ); }
+  ~Mutex() { ::DeleteCriticalSection( &_cs ); }
+  void lock() { ::EnterCriticalSection( &_cs ); }
+  void unlock() { ::LeaveCriticalSection( &_cs ); }
+#elif defined(OC3_PLATFORM_UNIX)
+  Mutex() { pthread_mutex_init( &_mutex, 0 ); }
+  ~Mutex() { pthread_mutex_destroy( &_mutex ); }
+  void lock() { pthread_mutex_lock( &_mutex ); }
+  void unlock() { pthread_mutex_unlock( &_mutex ); }
+#endif
+
+private:
+  Mutex( const Mutex& );
+  Mutex& operator=( const Mutex& );
+
+#if defined(OC3_PLATFORM_WIN)
+  CRITICAL_SECTION _cs;
+#elif defined(OC3_PLATFORM_UNIX)
+  pthread_mutex_t _mutex;
+#endif
+};
+
+class Semaphore
+{
+public:
+#if defined(OC3_PLATFORM_WIN)
+  Semaphore() { _handle = ::CreateSemaphore( 0, 0, 0x7fffffff, 0 ); }
+  ~Semaphore() { ::CloseHandle( _handle ); }
+  void post() { ::ReleaseSemaphore( _handle, 1, 0 ); }
+  void wait() { ::WaitForSingleObject( _handle, INFINITE ); }
+#elif defined(OC3_PLATFORM_UNIX)
+  // unnamed posix semaphores are missing on mac, so built on condition
+  Semaphore() : _count( 0 )
+  {
+    pthread_mutex_init( &_mutex, 0 );
+    pthread_cond_init( &_cond, 0 );
+  }
+
+  ~Semaphore()
+  {
+    pthread_cond_destroy( &_cond );
+    pthread_mutex_destroy( &_mutex );
+  }
+
+  void post()
+  {
+    pthread_mutex_lock( &_mutex );
+    _count++;
+    pthread_cond_signal( &_cond );
+    pthread_mutex_unlock( &_mutex );
+  }
+
+  void wait()
+  {
+    pthread_mutex_lock( &_mutex );
+    while( _count == 0 )
+    {
+      pthread_cond_wait( &_cond, &_mutex );
+    }
+    _count--;
+    pthread_mutex_unlock( &_mutex );
+  }
+#endif
+
+private:
+  Semaphore( const Semaphore& );
+  Semaphore& operator=( const Semaphore& );
+
+#if defined(OC3_PLATFORM_WIN)
+  HANDLE _handle;
+#elif defined(OC3_PLATFORM_UNIX)
+  pthread_mutex_t _mutex;
+  pthread_cond_t _cond;
+  unsigned int _count;
+#endif
+};
+
+// chunks [begin, end) of one thread, owner takes them from begin, thieves from end
+struct Run
+{
+  Mutex mutex;
+  unsigned int begin;
+  unsigned int end;
+  Semaphore start;  // posted once per task, so every worker does every task once
+};
+
+}
+
+class ThreadPool::Impl
+{
+public:
+  struct Worker
+  {
+    Impl* pool;
+    unsigned int index;
+#if defined(OC3_PLATFORM_WIN)
+    HANDLE handle;
+#elif defined(OC3_PLATFORM_UNIX)
+    pthread_t handle;
+#endif
+  };
+
+  unsigned int threadsCount;
+  std::vector< Run* > runs;  // index=thread, 0 - caller thread
+  std::vector< Worker* > workers;
+  Semaphore done;
+  Task* task;
+  unsigned int count;
+  unsigned int grain;
+  bool quit;
+
+  bool takeChunk( unsigned int thread, unsigned int& chunk )
+  {
+    Run& own = *runs[ thread ];
+    own.mutex.lock();
+    bool found = own.begin < own.end;
+    if( found )
+    {
+      chunk = own.begin++;
+    }
+    own.mutex.unlock();
+
+    for( unsigned int k=1; !found && k < runs.size(); k++ )
+    {
+      Run& victim = *runs[ (thread + k) % runs.size() ];
+      victim.mutex.lock();
+      found = victim.begin < victim.end;
+      if( found )
+      {
+        chunk = --victim.end;
+      }
+      victim.mutex.unlock();
+    }
+
+    return found;
+  }
+
+  void work( unsigned int thread )
+  {
+    unsigned int chunk;
+    while( takeChunk( thread, chunk ) )
+    {
+      const unsigned int begin = chunk * grain;
+      task->run( begin, std::min( begin + grain, count ) );
+    }
+  }
+
+  void workerLoop( unsigned int index )
+  {
+    while( true )
+    {
+      runs[ index ]->start.wait();
+      if( quit )
+      {
+        return;
+      }
+
+      work( index );
+      done.post();
+    }
+  }
+
+#if defined(OC3_PLATFORM_WIN)
+  static DWORD WINAPI threadEntry( LPVOID param )
+#elif defined(OC3_PLATFORM_UNIX)
+  static void* threadEntry( void* param )
+#endif
+  {
+    Worker* worker = static_cast< Worker* >( param );
+    worker->pool->workerLoop( worker->index );
+    return 0;
+  }
+
+  void startWorkers()
+  {
+    quit = false;
+    for( unsigned int index=0; index < threadsCount; index++ )
+    {
+      runs.push_back( new Run() );
+    }
+
+    for( unsigned int index=1; index < threadsCount; index++ )
+    {
+      Worker* worker = new Worker();
+      worker->pool = this;
+      worker->index = index;
+#if defined(OC3_PLATFORM_WIN)
+      worker->handle = ::CreateThread( 0, 0, &Impl::threadEntry, worker, 0, 0 );
+      bool started = worker->handle != 0;
+#elif defined(OC3_PLATFORM_UNIX)
+      bool started = pthread_create( &worker->handle, 0, &Impl::threadEntry, worker ) == 0;
+#endif
+      if( !started )
+      {
+        Logger::warning( "ThreadPool: can't start thread %d", index );
+        delete worker;
+        break;
+      }
+
+      workers.push_back( worker );
+    }
+
+    // threads which did not start leave their runs
+    while( runs.size() > workers.size() + 1 )
+    {
+      delete runs.back();
+      runs.pop_back();
+    }
+  }
+
+  void stopWorkers()
+  {
+    quit = true;
+    for( unsigned int k=0; k < workers.size(); k++ )
+    {
+      runs[ workers[ k ]->index ]->start.post();
+    }
+
+    for( unsigned int k=0; k < workers.size(); k++ )
+    {
+#if defined(OC3_PLATFORM_WIN)
+      ::WaitForSingleObject( workers[ k ]->handle, INFINITE );
+      ::CloseHandle( workers[ k ]->handle );
+#elif defined(OC3_PLATFORM_UNIX)
+      pthread_join( workers[ k ]->handle, 0 );
+#endif
+      delete workers[ k ];
+    }
+
+    workers.clear();
+    for( unsigned int k=0; k < runs.size(); k++ )
+    {
+      delete runs[ k ];
+    }
+    runs.clear();
+  }
+};
+
+ThreadPool& ThreadPool::instance()
+{
+  static ThreadPool inst;
+  return inst;
+}
+
+unsigned int ThreadPool::getCpuCount()
+{
+#if defined(OC3_PLATFORM_WIN)
+  SYSTEM_INFO info;
+  ::GetSystemInfo( &info );
+  return std::max<unsigned int>( info.dwNumberOfProcessors, 1 );
+#elif defined(OC3_PLATFORM_UNIX)
+  long count = sysconf( _SC_NPROCESSORS_ONLN );
+  return count > 0 ? (unsigned int)count : 1;
+#endif
+}
+
+ThreadPool::ThreadPool() : _d( new Impl )
+{
+  _d->threadsCount = 0;
+  _d->task = 0;
+  _d->count = 0;
+  _d->grain = 1;
+  _d->quit = false;
+
+  setThreadsCount( getCpuCount() );
+}
+
+ThreadPool::~ThreadPool()
+{
+  _d->stopWorkers();
+}
+
+void ThreadPool::setThreadsCount( unsigned int count )
+{
+  count = math::clamp<unsigned int>( count, 1, maxThreadsCount );
+  if( count == _d->threadsCount )
+  {
+    return;
+  }
+
+  _d->stopWorkers();
+  _d->threadsCount = count;
+  _d->startWorkers();
+}
+
+unsigned int ThreadPool::getThreadsCount() const
+{
+  return _d->runs.size();
+}
+
+void ThreadPool::parallelFor( unsigned int count, Task& task, unsigned int grain )
+{
+  grain = std::max<unsigned int>( grain, 1 );
+  const unsigned int threads = _d->runs.size();
+  if( threads < 2 || count <= grain )
+  {
+    task.run( 0, count );
+    return;
+  }
+
+  const unsigned int chunks = ( count + grain - 1 ) / grain;
+  _d->task = &task;
+  _d->count = count;
+  _d->grain = grain;
+  for( unsigned int k=0; k < threads; k++ )
+  {
+    _d->runs[ k ]->begin = chunks * k / threads;
+    _d->runs[ k ]->end = chunks * (k + 1) / threads;
+  }
+
+  for( unsigned int k=1; k < threads; k++ )
+  {
+    _d->runs[ k ]->start.post();
+  }
+
+  _d->work( 0 );
+
+  for( unsigned int k=1; k < threads; k++ )
+  {
+    _d->done.wait();
+  }
+
+  _d->task = 0;
+}
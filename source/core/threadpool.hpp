@@ -0,0 +1,60 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __OPENCAESAR3_THREADPOOL_H_INCLUDED__
+#define __OPENCAESAR3_THREADPOOL_H_INCLUDED__
+
+#include "core/scopedptr.hpp"
+
+//! Worker threads for the read-only think phase of simulation.
+/** parallelFor() cuts items into chunks and gives every thread an equal run
+    of them, a thread which finished its run steals chunks from the end of
+    other runs. Caller thread works as thread 0 and returns when all chunks
+    are done. Tasks must not allocate through MemoryPool or touch reference
+    counters of shared objects, neither of them is thread safe. */
+class ThreadPool
+{
+public:
+  class Task
+  {
+  public:
+    virtual ~Task() {}
+
+    //! processes items [begin, end), may be called from any thread
+    virtual void run( unsigned int begin, unsigned int end ) = 0;
+  };
+
+  static ThreadPool& instance();
+
+  //! number of processors available to the process
+  static unsigned int getCpuCount();
+
+  //! 1 runs every task in caller thread
+  void setThreadsCount( unsigned int count );
+  unsigned int getThreadsCount() const;
+
+  //! runs task over items [0, count), chunks of grain items are distributed between threads
+  void parallelFor( unsigned int count, Task& task, unsigned int grain=256 );
+
+  ~ThreadPool();
+
+private:
+  ThreadPool();
+
+  class Impl;
+  ScopedPtr< Impl > _d;
+};
+
+#endif //__OPENCAESAR3_THREADPOOL_H_INCLUDED__
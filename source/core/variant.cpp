@@ -1085,6 +1085,31 @@ Variant::Variant(const Variant &p)
   }
 }
 
+#if __cplusplus >= 201103L
+// inline values are trivially copyable and heap values are owned by pointer,
+// so stealing the storage is a plain copy of the impl
+Variant::Variant(Variant&& p)
+    : _d(p._d)
+{
+  p._d.type = Invalid;
+  p._d.is_null = true;
+}
+
+Variant::Variant(VariantList&& rlist)
+{
+  _d.is_null = false; _d.type = Variant::List;
+  v_construct<VariantList>(&_d, 0);
+  v_cast<VariantList>(&_d)->swap( rlist );
+}
+
+Variant::Variant(VariantMap&& rmap)
+{
+  _d.is_null = false; _d.type = Variant::Map;
+  v_construct<VariantMap>(&_d, 0);
+  v_cast<VariantMap>(&_d)->swap( rmap );
+}
+#endif
+
 /*
 Variant::Variant(const char *val)
 {
@@ -1212,6 +1237,21 @@ Variant& Variant::operator=(const Variant &variant)
   return *this;
 }
 
+#if __cplusplus >= 201103L
+Variant& Variant::operator=(Variant&& variant)
+{
+  if (this == &variant)
+      return *this;
+
+  clear();
+  _d = variant._d;
+  variant._d.type = Invalid;
+  variant._d.is_null = true;
+
+  return *this;
+}
+#endif
+
 std::string Variant::typeName() const
 {
     return typeToName( Type(_d.type) );
@@ -1914,7 +1954,9 @@ bool Variant::cmp(const Variant &v) const
 
 const void *Variant::constData() const
 {
-    return reinterpret_cast<const void *>(_d.data.ptr);
+    return v_isInline( _d.type )
+             ? reinterpret_cast<const void *>(&_d.data)
+             : reinterpret_cast<const void *>(_d.data.ptr);
 }
 
 /*!
@@ -24,7 +24,7 @@
 #include "position.hpp"
 #include "rectangle.hpp"
 
-#include <list>
+#include <vector>
 #include <map>
 #include <typeinfo>
 
@@ -65,6 +65,7 @@ struct Variant2Impl
         unsigned long long ull;
         ReferenceCounted* o;
         void* ptr;
+        int buf[ 4 ];  // inline storage for points, sizes and rects
     } data;
     unsigned int type : 30;
     unsigned int reserved : 1;
@@ -147,6 +148,11 @@ class Variant
     Variant( int typeOrUserType, const void *copy);
     Variant( int typeOrUserType, const void *copy, unsigned int flags);
     Variant( const Variant &other);
+#if __cplusplus >= 201103L
+    Variant( Variant&& other );
+    Variant( VariantList&& list );
+    Variant( VariantMap&& mapa );
+#endif
 
     Variant( int i );
     Variant( unsigned int ui);
@@ -176,6 +182,9 @@ class Variant
     //Variant( const Color& color);
 
     Variant& operator=( const Variant& other);
+#if __cplusplus >= 201103L
+    Variant& operator=( Variant&& other );
+#endif
 
     Type type() const;
     int userType() const;
@@ -253,23 +262,14 @@ private:
     inline Variant(bool, int) { _OC3_DEBUG_BREAK_IF(true); }
 };
 
-class VariantList : public std::list<Variant>
+class VariantList : public std::vector<Variant>
 {
 public:
   VariantList() {}
 
   Variant get( const unsigned int index, Variant defaultVal=Variant() ) const
   {
-    VariantList::const_iterator it = begin();
-    if( index >= size() )
-    {
-      return defaultVal;
-    }
-    else
-    {
-      std::advance( it, index );
-      return *it;
-    }
+    return index < size() ? at( index ) : defaultVal;
   }
 
   template<class T>
@@ -303,9 +303,25 @@ public:
   VariantMap() {}
 
   VariantMap( const VariantMap& other )
+    : std::map<std::string, Variant>( other )
+  {
+  }
+
+#if __cplusplus >= 201103L
+  VariantMap( VariantMap&& other )
+  {
+    swap( other );
+  }
+
+  // keeps merge semantics of copy assignment when this map is not empty
+  VariantMap& operator=( VariantMap&& other )
   {
-    *this = other;
+    if( empty() ) { swap( other ); }
+    else { *this = static_cast< const VariantMap& >( other ); }
+
+    return *this;
   }
+#endif
 
   VariantMap& operator=(const VariantMap& other )
   {
@@ -18,46 +18,108 @@
 #define __OPENCAESAR3_VARIANTPRIVATE_H_INCLUDED__
 
 #include "variant.hpp"
+#include <new>
+
+// small types are kept inside Variant2Impl::data, others live on heap
+template <typename T> struct VariantInline { enum { value=0 }; };
+template <> struct VariantInline<Point> { enum { value=1 }; };
+template <> struct VariantInline<PointF> { enum { value=1 }; };
+template <> struct VariantInline<TilePos> { enum { value=1 }; };
+template <> struct VariantInline<Size> { enum { value=1 }; };
+template <> struct VariantInline<SizeF> { enum { value=1 }; };
+template <> struct VariantInline<Rect> { enum { value=1 }; };
+template <> struct VariantInline<RectF> { enum { value=1 }; };
+
+inline bool v_isInline( unsigned int type )
+{
+  switch( type )
+  {
+  case Variant::NPoint: case Variant::NPointF: case Variant::NTilePos:
+  case Variant::NSize: case Variant::NSizeF:
+  case Variant::NRectI: case Variant::NRectF:
+    return true;
+
+  default: return false;
+  }
+}
+
+// heap storage, data.ptr owns the value
+template <class T, int isInline=VariantInline<T>::value>
+struct VariantStorage
+{
+  static inline void* get( const Variant2Impl* d ) { return d->data.ptr; }
+
+  static inline void construct( Variant2Impl* x, const void* copy )
+  {
+    if (copy)
+    {
+      x->data.ptr = (void*)new T(*static_cast<const T *>(copy));
+    }
+    else
+    {
+      x->data.ptr = (void*)new T();
+    }
+  }
+
+  static inline void clear( Variant2Impl* d )
+  {
+    //now we need to cast
+    //because Variant2::PrivateShared doesn't have a virtual destructor
+    delete static_cast< T* >(d->data.ptr);
+  }
+};
+
+// inline storage, value is placed into data itself
+template <class T>
+struct VariantStorage<T, 1>
+{
+  static inline void* get( const Variant2Impl* d ) { return const_cast< Variant2Impl::Data* >( &d->data ); }
+
+  static inline void construct( Variant2Impl* x, const void* copy )
+  {
+    typedef char TypeIsTooBig[ sizeof(T) <= sizeof(x->data) ? 1 : -1 ];
+    (void)sizeof(TypeIsTooBig);
+
+    if( copy ) { new (&x->data) T(*static_cast<const T *>(copy)); }
+    else { new (&x->data) T(); }
+  }
+
+  static inline void clear( Variant2Impl* d )
+  {
+    static_cast< T* >( get( d ) )->~T();
+  }
+};
 
 template <typename T>
 inline const T *v_cast(const Variant2Impl *d, T * = 0)
 {
-  return static_cast<const T *>(static_cast<const void *>(d->data.ptr));
+  return static_cast<const T *>(VariantStorage<T>::get( d ));
 }
 
 template <typename T>
 inline T *v_cast(Variant2Impl *d, T * = 0)
 {
-  return static_cast<T *>(static_cast<void *>(d->data.ptr));
+  return static_cast<T *>(VariantStorage<T>::get( d ));
 }
 
 // constructs a new variant if copy is 0, otherwise copy-constructs
 template <class T>
 inline void v_construct(Variant2Impl *x, const void *copy, T * = 0)
 {
-  if (copy)
-  {
-    x->data.ptr = (void*)new T(*static_cast<const T *>(copy));
-  }
-  else
-  {
-    x->data.ptr = (void*)new T();
-  }
+  VariantStorage<T>::construct( x, copy );
 }
 
 template <class T>
 inline void v_construct(Variant2Impl* x, const T& t)
 {
-    x->data.ptr = (void*)new T(t);
+  VariantStorage<T>::construct( x, &t );
 }
 
 // deletes the internal structures
 template <class T>
 inline void v_clear(Variant2Impl *d, T* = 0)
 {    
-  //now we need to cast
-  //because Variant2::PrivateShared doesn't have a virtual destructor
-  delete static_cast< T* >(d->data.ptr);
+  VariantStorage<T>::clear( d );
 }
 
 #endif // __OPENCAESAR3_VARIANTPRIVATE_H_INCLUDED__
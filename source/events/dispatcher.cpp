@@ -15,6 +15,10 @@
 
 #include "dispatcher.hpp"
 #include "core/foreach.hpp"
+#include "core/variant.hpp"
+#include "core/saveadapter.hpp"
+#include "core/random.hpp"
+#include "core/logger.hpp"
 #include <vector>
 
 namespace events
@@ -23,16 +27,118 @@ namespace events
 class Dispatcher::Impl
 {
 public:
-  typedef std::vector< GameEventPtr > Events;
+  struct Item
+  {
+    GameEventPtr event;
+    bool derived;  // appended by other event, will appear on replay again
+  };
+
+  typedef std::vector< Item > Events;
 
   Events events;
+  bool emitting;
+
+  bool recording;
+  io::FilePath recordFile;
+  io::FilePath recordSave;
+  unsigned int recordSeed;
+  VariantList recorded;
+
+  VariantList replay;
+  unsigned int replayIndex;
+
+  GameEventPtr createEvent( const std::string& name );
+  void record( unsigned int time, GameEventPtr event );
+  void feedReplay( unsigned int time );
 
 public oc3_signals:
   Signal1<GameEventPtr> onEventSignal;
 };
 
+// events which are not written to replay file: simulation creates them
+// again while replay runs, or they don't change the game
+static const char* regeneratedEvents[] = {
+  "disaster",         // fire, collapse and plague of constructions
+  "trade",            // import and export paid by merchants
+  "warning_message",  // city warnings
+  "show_infobox",     // messages of divinities
+  "show_feast_window",// festival results
+  "set_video_options",// settings of this computer, not of the game
+  0
+};
+
+GameEventPtr Dispatcher::Impl::createEvent( const std::string& name )
+{
+  GameEvent* ev = 0;
+  if( name == "build" ) { ev = new BuildEvent(); }
+  else if( name == "clear_land" ) { ev = new ClearLandEvent(); }
+  else if( name == "pause" ) { ev = new Pause(); }
+  else if( name == "change_speed" ) { ev = new ChangeSpeed(); }
+  else if( name == "fund_issue" ) { ev = new FundIssueEvent(); }
+  else if( name == "show_empire_map" ) { ev = new ShowEmpireMapWindow(); }
+  else if( name == "show_advisor" ) { ev = new ShowAdvisorWindow(); }
+
+  GameEventPtr ret( ev );
+  if( ev ) { ret->drop(); }
+
+  return ret;
+}
+
+void Dispatcher::Impl::record( unsigned int time, GameEventPtr event )
+{
+  std::string name = event->getName();
+  for( int i=0; regeneratedEvents[ i ] != 0; i++ )
+  {
+    if( name == regeneratedEvents[ i ] )
+      return;
+  }
+
+  if( createEvent( name ).isNull() )
+  {
+    Logger::warning( "Record: event %s can't be replayed", name.c_str() );
+    return;
+  }
+
+  VariantMap vm_event;
+  event->save( vm_event );
+  vm_event[ "time" ] = time;
+  vm_event[ "name" ] = Variant( name );
+
+  recorded.push_back( vm_event );
+}
+
+void Dispatcher::Impl::feedReplay( unsigned int time )
+{
+  while( replayIndex < replay.size() )
+  {
+    VariantMap vm_event = replay.get( replayIndex ).toMap();
+    if( vm_event.get( "time" ).toUInt() > time )
+      break;
+
+    replayIndex++;
+
+    GameEventPtr event = createEvent( vm_event.get( "name" ).toString() );
+    if( event.isNull() )
+    {
+      Logger::warning( "Replay: unknown event %s", vm_event.get( "name" ).toString().c_str() );
+      continue;
+    }
+
+    event->load( vm_event );
+
+    Item item;
+    item.event = event;
+    item.derived = true;  // already in replay file
+    events.push_back( item );
+  }
+}
+
 Dispatcher::Dispatcher() : _d( new Impl )
 {
+  _d->emitting = false;
+  _d->recording = false;
+  _d->recordSeed = 0;
+  _d->replayIndex = 0;
 }
 
 Dispatcher::~Dispatcher()
@@ -42,19 +148,84 @@ Dispatcher::~Dispatcher()
 
 void Dispatcher::append( GameEventPtr event)
 {
-  instance()._d->events.push_back( event );
+  Impl::Item item;
+  item.event = event;
+  item.derived = instance()._d->emitting;
+
+  instance()._d->events.push_back( item );
 }
 
 void Dispatcher::update(unsigned int time)
 {
   Dispatcher& inst = instance();
+  inst._d->feedReplay( time );
+
   Impl::Events events = inst._d->events;
   inst._d->events.clear();
 
-  foreach( GameEventPtr event, events )
+  inst._d->emitting = true;
+  foreach( Impl::Item& item, events )
+  {
+    if( inst._d->recording && !item.derived )
+    {
+      inst._d->record( time, item.event );
+    }
+
+    inst._d->onEventSignal.emit( item.event );
+  }
+  inst._d->emitting = false;
+}
+
+void Dispatcher::startRecording( const io::FilePath& filename, const io::FilePath& save, Random& random )
+{
+  Dispatcher& inst = instance();
+  inst._d->recording = true;
+  inst._d->recordFile = filename;
+  inst._d->recordSave = save;
+  inst._d->recordSeed = random.getState();
+  inst._d->recorded.clear();
+}
+
+void Dispatcher::stopRecording()
+{
+  Dispatcher& inst = instance();
+  if( !inst._d->recording )
+    return;
+
+  VariantMap vm_replay;
+  vm_replay[ "save" ] = Variant( inst._d->recordSave.toString() );
+  vm_replay[ "random" ] = inst._d->recordSeed;
+  vm_replay[ "events" ] = inst._d->recorded;
+
+  SaveAdapter::save( vm_replay, inst._d->recordFile );
+  Logger::warning( "Recorded %d events to %s", (int)inst._d->recorded.size(), inst._d->recordFile.toString().c_str() );
+
+  inst._d->recording = false;
+  inst._d->recorded.clear();
+}
+
+bool Dispatcher::startReplay( const io::FilePath& filename, Random& random )
+{
+  VariantMap vm_replay = SaveAdapter::load( filename );
+  if( vm_replay.empty() )
   {
-   inst._d->onEventSignal.emit( event );
+    Logger::warning( "Can't load replay from %s", filename.toString().c_str() );
+    return false;
   }
+
+  Dispatcher& inst = instance();
+  random.setState( vm_replay.get( "random" ).toUInt() );
+  inst._d->replay = vm_replay.get( "events" ).toList();
+  inst._d->replayIndex = 0;
+
+  return true;
+}
+
+void Dispatcher::stopReplay()
+{
+  Dispatcher& inst = instance();
+  inst._d->replay.clear();
+  inst._d->replayIndex = 0;
 }
 
 Signal1<GameEventPtr>&Dispatcher::onEvent()
@@ -21,6 +21,9 @@
 #include "event.hpp"
 #include "core/singleton.hpp"
 #include "core/signals.hpp"
+#include "vfs/filepath.hpp"
+
+class Random;
 
 namespace events
 {
@@ -34,6 +37,13 @@ public:
   static void append( GameEventPtr event );
   static void update( unsigned int time );
 
+  // player input with game time is written to file, replay feeds it back;
+  // replay file keeps the save it starts from and state of city random
+  static void startRecording( const io::FilePath& filename, const io::FilePath& save, Random& random );
+  static void stopRecording();
+  static bool startReplay( const io::FilePath& filename, Random& random );
+  static void stopReplay();
+
 public oc3_signals:
   Signal1<GameEventPtr>& onEvent();
 
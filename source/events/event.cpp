@@ -91,6 +91,8 @@ void DisasterEvent::exec( Game& game )
   }
 }
 
+std::string DisasterEvent::getName() const { return "disaster"; }
+
 GameEventPtr BuildEvent::create( const TilePos& pos, const TileOverlay::Type type )
 {
   return create( pos, TileOverlayFactory::getInstance().create( type ) );
@@ -132,6 +134,20 @@ void BuildEvent::exec( Game& game )
   }
 }
 
+std::string BuildEvent::getName() const { return "build"; }
+
+void BuildEvent::save( VariantMap& stream ) const
+{
+  stream[ "pos" ] = _pos;
+  stream[ "type" ] = _overlay.isValid() ? _overlay->getType() : 0;
+}
+
+void BuildEvent::load( const VariantMap& stream )
+{
+  _pos = stream.get( "pos" ).toTilePos();
+  _overlay = TileOverlayFactory::getInstance().create( (TileOverlay::Type)stream.get( "type" ).toInt() );
+}
+
 GameEventPtr ClearLandEvent::create(const TilePos& pos)
 {
   ClearLandEvent* ev = new ClearLandEvent();
@@ -201,17 +217,21 @@ void ClearLandEvent::exec( Game& game )
       }
     }
 
-    // recompute roads;
-    // there is problem that we NEED to recompute all roads map for all buildings
-    // because MaxDistance2Road can be any number
-    //
+    // recompute access roads of constructions near cleared tiles
     if( deleteRoad )
     {
-      game.getCity()->updateRoads();
+      foreach( Tile* tile, clearedTiles )
+      {
+        game.getCity()->updateRoads( tile->getIJ() );
+      }
     }
   }
 }
 
+std::string ClearLandEvent::getName() const { return "clear_land"; }
+void ClearLandEvent::save( VariantMap& stream ) const { stream[ "pos" ] = _pos; }
+void ClearLandEvent::load( const VariantMap& stream ) { _pos = stream.get( "pos" ).toTilePos(); }
+
 GameEventPtr ShowInfoboxEvent::create( const std::string& title, const std::string& text )
 {
   ShowInfoboxEvent* ev = new ShowInfoboxEvent();
@@ -230,6 +250,8 @@ void ShowInfoboxEvent::exec( Game& game )
   msgWnd->show();
 }
 
+std::string ShowInfoboxEvent::getName() const { return "show_infobox"; }
+
 
 GameEventPtr Pause::create( Mode mode )
 {
@@ -280,6 +302,10 @@ void Pause::exec(Game& game)
 }
 
 
+std::string Pause::getName() const { return "pause"; }
+void Pause::save( VariantMap& stream ) const { stream[ "mode" ] = (int)_mode; }
+void Pause::load( const VariantMap& stream ) { _mode = (Mode)stream.get( "mode" ).toInt(); }
+
 GameEventPtr ChangeSpeed::create(int value)
 {
   ChangeSpeed* ev = new ChangeSpeed();
@@ -294,6 +320,10 @@ void ChangeSpeed::exec(Game& game)
   game.changeTimeMultiplier( _value );
 }
 
+std::string ChangeSpeed::getName() const { return "change_speed"; }
+void ChangeSpeed::save( VariantMap& stream ) const { stream[ "value" ] = _value; }
+void ChangeSpeed::load( const VariantMap& stream ) { _value = stream.get( "value" ).toInt(); }
+
 
 GameEventPtr FundIssueEvent::create(int type, int value)
 {
@@ -343,6 +373,24 @@ void FundIssueEvent::exec(Game& game)
   game.getCity()->getFunds().resolveIssue( FundIssue( _type, _value ) );
 }
 
+std::string FundIssueEvent::getName() const
+{
+  bool trade = ( _type == CityFunds::importGoods || _type == CityFunds::exportGoods );
+  return trade ? "trade" : "fund_issue";
+}
+
+void FundIssueEvent::save( VariantMap& stream ) const
+{
+  stream[ "type" ] = _type;
+  stream[ "value" ] = _value;
+}
+
+void FundIssueEvent::load( const VariantMap& stream )
+{
+  _type = stream.get( "type" ).toInt();
+  _value = stream.get( "value" ).toInt();
+}
+
 
 GameEventPtr ShowEmpireMapWindow::create(bool show)
 {
@@ -377,6 +425,9 @@ void ShowEmpireMapWindow::exec(Game& game)
   }
 }
 
+std::string ShowEmpireMapWindow::getName() const { return "show_empire_map"; }
+void ShowEmpireMapWindow::save( VariantMap& stream ) const { stream[ "show" ] = _show; }
+void ShowEmpireMapWindow::load( const VariantMap& stream ) { _show = stream.get( "show" ).toBool(); }
 
 GameEventPtr ShowAdvisorWindow::create(bool show, int advisor)
 {
@@ -413,6 +464,20 @@ void ShowAdvisorWindow::exec(Game& game)
   }
 }
 
+std::string ShowAdvisorWindow::getName() const { return "show_advisor"; }
+
+void ShowAdvisorWindow::save( VariantMap& stream ) const
+{
+  stream[ "show" ] = _show;
+  stream[ "advisor" ] = _advisor;
+}
+
+void ShowAdvisorWindow::load( const VariantMap& stream )
+{
+  _show = stream.get( "show" ).toBool();
+  _advisor = stream.get( "advisor" ).toInt();
+}
+
 GameEventPtr WarningMessageEvent::create(const std::string& text)
 {
   WarningMessageEvent* ev = new WarningMessageEvent();
@@ -433,6 +498,8 @@ void WarningMessageEvent::exec(Game& game)
   }
 }
 
+std::string WarningMessageEvent::getName() const { return "warning_message"; }
+
 void events::GameEvent::dispatch()
 {
   Dispatcher::append( this );
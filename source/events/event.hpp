@@ -33,6 +33,12 @@ public:
   virtual void exec( Game& game ) = 0;
   virtual void dispatch();
 
+  // every event has name; player input events also save parameters and
+  // are written to replay, others are listed in dispatcher as regenerated
+  virtual std::string getName() const = 0;
+  virtual void save( VariantMap& stream ) const {}
+  virtual void load( const VariantMap& stream ) {}
+
 protected:
   GameEvent() {}
 };
@@ -47,6 +53,7 @@ public:
   static GameEventPtr create( const TilePos&, Type type );
 
   virtual void exec( Game& game );
+  virtual std::string getName() const;
 
 private:
   TilePos _pos;
@@ -60,6 +67,9 @@ public:
   static GameEventPtr create( const TilePos&, TileOverlayPtr overlay );
 
   virtual void exec( Game& game );
+  virtual std::string getName() const;
+  virtual void save( VariantMap& stream ) const;
+  virtual void load( const VariantMap& stream );
 private:
   TilePos _pos;
   TileOverlayPtr _overlay;
@@ -70,6 +80,9 @@ class ClearLandEvent : public GameEvent
 public:
   static GameEventPtr create( const TilePos& );
   virtual void exec( Game& game );
+  virtual std::string getName() const;
+  virtual void save( VariantMap& stream ) const;
+  virtual void load( const VariantMap& stream );
 private:
   TilePos _pos;
 };
@@ -79,6 +92,7 @@ class ShowInfoboxEvent : public GameEvent
 public:
   static GameEventPtr create( const std::string& title, const std::string& text );
   virtual void exec( Game& game );
+  virtual std::string getName() const;
 private:
   std::string _title, _text;
 };
@@ -88,6 +102,7 @@ class WarningMessageEvent : public GameEvent
 public:
   static GameEventPtr create( const std::string& text );
   virtual void exec( Game& game );
+  virtual std::string getName() const;
 private:
   std::string _text;
 };
@@ -97,6 +112,9 @@ class ShowEmpireMapWindow : public GameEvent
 public:
   static GameEventPtr create( bool show );
   virtual void exec( Game& game );
+  virtual std::string getName() const;
+  virtual void save( VariantMap& stream ) const;
+  virtual void load( const VariantMap& stream );
 
 private:
   bool _show;
@@ -107,6 +125,9 @@ class ShowAdvisorWindow : public GameEvent
 public:
   static GameEventPtr create( bool show, int advisor );
   virtual void exec( Game& game );
+  virtual std::string getName() const;
+  virtual void save( VariantMap& stream ) const;
+  virtual void load( const VariantMap& stream );
 
 private:
   bool _show;
@@ -119,6 +140,9 @@ public:
   typedef enum { toggle, pause, play, hidepause, hideplay } Mode;
   static GameEventPtr create( Mode mode );
   virtual void exec( Game& game );
+  virtual std::string getName() const;
+  virtual void save( VariantMap& stream ) const;
+  virtual void load( const VariantMap& stream );
 
 private:
   Mode _mode;
@@ -129,6 +153,9 @@ class ChangeSpeed : public GameEvent
 public:
   static GameEventPtr create( int value );
   virtual void exec( Game& game );
+  virtual std::string getName() const;
+  virtual void save( VariantMap& stream ) const;
+  virtual void load( const VariantMap& stream );
 
 private:
   int _value;
@@ -141,6 +168,11 @@ public:
   static GameEventPtr import( Good::Type good, int qty );
   static GameEventPtr exportg( Good::Type good, int qty );
   virtual void exec( Game& game );
+
+  // goods trade is made by merchants, other issues by player
+  virtual std::string getName() const;
+  virtual void save( VariantMap& stream ) const;
+  virtual void load( const VariantMap& stream );
 private:
   int _type;
   int _value;
@@ -43,6 +43,8 @@ void SetVideoSettings::exec(Game& game)
   CONNECT( dialog, onFullScreenChange(), this, SetVideoSettings::_setFullscreen );
 }
 
+std::string SetVideoSettings::getName() const { return "set_video_options"; }
+
 void SetVideoSettings::_setResolution(Size newSize)
 {
   GameSettings::set( GameSettings::resolution, newSize );
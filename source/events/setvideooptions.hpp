@@ -26,6 +26,7 @@ class SetVideoSettings : public GameEvent
 public:
   static GameEventPtr create();
   virtual void exec( Game& game );
+  virtual std::string getName() const;
 
 private:
   void _setResolution(Size);
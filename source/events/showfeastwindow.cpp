@@ -53,4 +53,6 @@ void ShowFeastWindow::exec(Game& game)
   CONNECT( dlg, onClose(), &game, Game::play );
 }
 
+std::string ShowFeastWindow::getName() const { return "show_feast_window"; }
+
 }
@@ -26,6 +26,7 @@ class ShowFeastWindow : public GameEvent
 public:
   static GameEventPtr create(std::string text, std::string title, std::string receiver);
   virtual void exec( Game& game );
+  virtual std::string getName() const;
 
 private:
   std::string _text;
@@ -14,6 +14,7 @@
 // along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "citizen_group.hpp"
+#include "core/random.hpp"
 
 int CitizenGroup::count() const
 {
@@ -48,13 +49,13 @@ int CitizenGroup::count( Age group ) const
   return ret;
 }
 
-CitizenGroup CitizenGroup::retrieve(int count)
+CitizenGroup CitizenGroup::retrieve(int count, Random& random )
 {
   CitizenGroup ret;
 
   while( count > 0 && size() > 0 )
   {
-    int groupIndex = rand() % size();
+    int groupIndex = random.get() % size();
     iterator g = begin();
     std::advance( g, groupIndex );
     if( g->second > 0 )
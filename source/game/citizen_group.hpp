@@ -18,6 +18,8 @@
 
 #include "core/variant.hpp"
 
+class Random;
+
 class CitizenGroup : public std::map< int, int >
 {
 public:
@@ -27,7 +29,8 @@ public:
   int count() const;
   int count( Age group ) const;
 
-  CitizenGroup retrieve( int count );
+  // takes citizens of random ages, random is the city generator
+  CitizenGroup retrieve( int count, Random& random );
 
   CitizenGroup& operator += ( const CitizenGroup& b );
 
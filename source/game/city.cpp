@@ -33,12 +33,18 @@
 #include "cityservice_shoreline.hpp"
 #include "cityservice_info.hpp"
 #include "cityservice_animals.hpp"
+#include "cityservice_water.hpp"
+#include "cityservice_firerisk.hpp"
+#include "cityservice_vacancies.hpp"
 #include "tilemap.hpp"
 #include "road.hpp"
 #include "core/time.hpp"
+#include "core/random.hpp"
 #include "core/variant.hpp"
 #include "core/stringhelper.hpp"
 #include "walkermanager.hpp"
+#include "walker/kinematics.hpp"
+#include "core/threadpool.hpp"
 #include "core/gettext.hpp"
 #include "build_options.hpp"
 #include "building/house.hpp"
@@ -70,6 +76,43 @@ using namespace constants;
 
 typedef std::vector< CityServicePtr > CityServices;
 
+namespace {
+
+// think phase of walkers: move intents of walkers which stay inside their tile
+class WalkersThink : public ThreadPool::Task
+{
+public:
+  WalkersThink( WalkerKinematics& kinematics ) : _kinematics( kinematics ) {}
+
+  virtual void run( unsigned int begin, unsigned int end )
+  {
+    _kinematics.think( begin, end );
+  }
+
+private:
+  WalkerKinematics& _kinematics;
+};
+
+// think phase of overlays: intents which overlays apply in their timeStep()
+class OverlaysThink : public ThreadPool::Task
+{
+public:
+  OverlaysThink( const std::vector< TileOverlay* >& overlays ) : _overlays( overlays ) {}
+
+  virtual void run( unsigned int begin, unsigned int end )
+  {
+    for( unsigned int k=begin; k < end; k++ )
+    {
+      _overlays[ k ]->think();
+    }
+  }
+
+private:
+  const std::vector< TileOverlay* >& _overlays;
+};
+
+}
+
 class WGrid
 {
 public:
@@ -120,19 +163,30 @@ public:
   int lastMonthCount;
   int population;
   CityFunds funds;  // amount of money
+  Random random;
   std::string name;
   EmpirePtr empire;
   PlayerPtr player;
 
   TileOverlayList overlayList;
   WalkerList walkerList;
+  TileOverlayList animatedOverlays;  // drawn by renderer only, simulation never touches it
 
   //walkers fast access map !!!
   WGrid walkersGrid;
   //*********************** !!!
 
+  // position and movement of all walkers
+  WalkerKinematicsPtr walkerKinematics;
+
+  // overlays which existed when overlay pass began, think phase runs over them,
+  // raw pointers because reference counters can't be touched from threads
+  std::vector< TileOverlay* > thinkingOverlays;
+
   CityServices services;
-  bool needRecomputeAllRoads;
+  SmartPtr< CityServiceVacancies > vacancies;
+  int roadAccessDistance;  // largest road access distance of city constructions
+  std::vector< TilePos > changedRoads;
   int lastMonthTax;
   int lastMonthTaxpayer;
   BorderInfo borderInfo;
@@ -146,6 +200,9 @@ public:
   ClimateType climate;   
   UniqueId walkerIdCount;
 
+  void updateAccessRoads( const std::vector< TilePos >& positions );
+  void appendOverlay( TileOverlayPtr overlay );
+
   // collect taxes from all houses
   void collectTaxes( CityPtr city);
   void payWages( CityPtr city );
@@ -168,11 +225,13 @@ City::City() : _d( new Impl )
   _d->borderInfo.boatExit = TilePos( 0, 0 );
   _d->funds.resolveIssue( FundIssue( CityFunds::donation, 1000 ) );
   _d->population = 0;
-  _d->needRecomputeAllRoads = false;
+  _d->roadAccessDistance = 0;
   _d->funds.setTaxRate( 7 );
   _d->walkerIdCount = 0;
+  _d->walkerKinematics = WalkerKinematics::create();
   _d->climate = C_CENTRAL;
   _d->lastMonthCount = GameDate::current().getMonth();
+  _d->random.setSeed( DateTime::getElapsedTime() );
 
   addService( CityServiceEmigrant::create( this ) );
   addService( CityServiceWorkersHire::create( this ) );
@@ -187,6 +246,11 @@ City::City() : _d( new Impl )
   addService( CityServiceRoads::create( this ) );
   addService( CityServiceFishPlace::create( this ) );
   addService( CityServiceDisorder::create( this ) );
+  addService( CityServiceWater::create( this ) );
+  addService( CityServiceFireRisk::create( this ) );
+
+  _d->vacancies = CityServiceVacancies::create( this ).as<CityServiceVacancies>();
+  addService( _d->vacancies.as<CityService>() );
 }
 
 void City::timeStep( unsigned int time )
@@ -204,8 +268,24 @@ void City::timeStep( unsigned int time )
     _d->walkersGrid.append( walker );
   }
 
+  // every pass has think phase, which runs on all threads, only reads city
+  // and writes intents of its own objects, and commit phase, which applies
+  // intents and runs timeStep() in list order on this thread, so result does
+  // not depend on threads count
+  ThreadPool& threadPool = ThreadPool::instance();
+
+  // walkers which stay inside their tile are moved here at once, the rest
+  // walk in their timeStep() when they cross tile border or tile center
+  WalkersThink walkersThink( *_d->walkerKinematics.object() );
+  threadPool.parallelFor( _d->walkerKinematics->getSlotsCount(), walkersThink );
+  _d->walkerKinematics->commit( _d->tilemap );
+
+  // objects spawned during a pass are appended to the lists at once, so lookups
+  // find them, but each pass updates only objects which existed when it began:
+  // a new object gets its first update on next pass, wherever it was created
+  unsigned int walkersCount = _d->walkerList.size();
   WalkerList::iterator walkerIt = _d->walkerList.begin();
-  while (walkerIt != _d->walkerList.end())
+  for( ; walkersCount > 0; walkersCount-- )
   {
     try
     {
@@ -227,8 +307,19 @@ void City::timeStep( unsigned int time )
     }
   }
 
+  // overlays think after walkers, which change fire and damage of buildings
+  unsigned int overlaysCount = _d->overlayList.size();
+  _d->thinkingOverlays.clear();
+  for( TileOverlayList::iterator it=_d->overlayList.begin(); it != _d->overlayList.end(); it++ )
+  {
+    _d->thinkingOverlays.push_back( (*it).object() );
+  }
+
+  OverlaysThink overlaysThink( _d->thinkingOverlays );
+  threadPool.parallelFor( _d->thinkingOverlays.size(), overlaysThink );
+
   TileOverlayList::iterator overlayIt = _d->overlayList.begin();
-  while( overlayIt != _d->overlayList.end() )
+  for( ; overlaysCount > 0; overlaysCount-- )
   {
     try
     {   
@@ -237,6 +328,7 @@ void City::timeStep( unsigned int time )
       if( (*overlayIt)->isDeleted() )
       {
         _d->beforeOverlayDestroyed( this, *overlayIt );
+        _d->animatedOverlays.remove( *overlayIt );
         // remove the overlay from the overlay list
         (*overlayIt)->destroy();
         overlayIt = _d->overlayList.erase(overlayIt);
@@ -267,25 +359,11 @@ void City::timeStep( unsigned int time )
       serviceIt++;
   }
 
-  if( _d->needRecomputeAllRoads )
+  if( !_d->changedRoads.empty() )
   {
-    _d->needRecomputeAllRoads = false;
-    foreach( TileOverlayPtr overlay, _d->overlayList )
-    {
-      // for each overlay
-      ConstructionPtr construction = overlay.as<Construction>();
-      if( construction != NULL )
-      {
-        // overlay matches the filter
-        construction->computeAccessRoads();
-        // for some constructions we need to update picture
-        if( construction->getType() == construction::road )
-        {
-          RoadPtr road = construction.as<Road>();
-          road->updatePicture();
-        }
-      }
-    }   
+    _d->updateAccessRoads( _d->changedRoads );
+    _d->changedRoads.clear();
+    _d->vacancies->invalidate();
   }
 }
 
@@ -355,14 +433,18 @@ void City::setBorderInfo(const BorderInfo& info)
   _d->borderInfo.boatEntry = info.boatEntry.fit( start, stop );
   _d->borderInfo.boatExit = info.boatExit.fit( start, stop );
   _d->walkersGrid.resize( Size(size) );
+  _d->vacancies->invalidate();
 }
 
 TileOverlayList&  City::getOverlays()         { return _d->overlayList; }
+TileOverlayList&  City::getAnimatedOverlays() { return _d->animatedOverlays; }
 const BorderInfo& City::getBorderInfo() const { return _d->borderInfo; }
 Tilemap&          City::getTilemap()          { return _d->tilemap; }
+WalkerKinematicsPtr City::getWalkerKinematics() const { return _d->walkerKinematics; }
 ClimateType       City::getClimate() const    { return _d->climate;    }
 void              City::setClimate(const ClimateType climate) { _d->climate = climate; }
 CityFunds&        City::getFunds() const      {  return _d->funds;   }
+Random&           City::getRandom()           {  return _d->random;  }
 int               City::getPopulation() const {   return _d->population; }
 
 void City::Impl::collectTaxes( CityPtr city )
@@ -410,6 +492,38 @@ void City::Impl::calculatePopulation( CityPtr city )
   onPopulationChangedSignal.emit( pop );
 }
 
+void City::Impl::updateAccessRoads( const std::vector< TilePos >& positions )
+{
+  // road tile can be in access list only of constructions
+  // which lay not far than their road access distance from it
+  const int maxRoadAccessDistance = roadAccessDistance;
+
+  std::set< Construction* > updated;
+  for( std::vector< TilePos >::const_iterator it=positions.begin(); it != positions.end(); it++ )
+  {
+    const TilePos& pos = *it;
+    for( int i=pos.getI() - maxRoadAccessDistance; i <= pos.getI() + maxRoadAccessDistance; i++ )
+    {
+      for( int j=pos.getJ() - maxRoadAccessDistance; j <= pos.getJ() + maxRoadAccessDistance; j++ )
+      {
+        if( !tilemap.isInside( TilePos( i, j ) ) )
+          continue;
+
+        ConstructionPtr construction = tilemap.at( i, j ).getOverlay().as<Construction>();
+        if( construction.isNull() || construction->isDeleted()
+            || !updated.insert( construction.object() ).second )
+          continue;
+
+        construction->computeAccessRoads();
+        if( construction->getType() == construction::road )
+        {
+          construction.as<Road>()->updatePicture();
+        }
+      }
+    }
+  }
+}
+
 void City::Impl::beforeOverlayDestroyed(CityPtr city, TileOverlayPtr overlay)
 {
   if( overlay.is<Construction>() )
@@ -496,6 +610,7 @@ void City::save( VariantMap& stream) const
   stream[ "funds" ] = _d->funds.save();
   stream[ "population" ] = _d->population;
   stream[ "name" ] = Variant( _d->name );
+  stream[ "random" ] = _d->random.getState();
 
   // walkers
   VariantMap vm_walkers;
@@ -537,6 +652,7 @@ void City::load( const VariantMap& stream )
   _d->population = (int)stream.get( "population", 0 );
   _d->cameraStart = TilePos( stream.get( "cameraStart" ).toTilePos() );
   _d->name = stream.get( "name" ).toString();
+  _d->random.setState( stream.get( "random", _d->random.getState() ).toUInt() );
   _d->lastMonthCount = GameDate::current().getMonth();
 
   VariantMap overlays = stream.get( "overlays" ).toMap();
@@ -553,7 +669,7 @@ void City::load( const VariantMap& stream )
     {
       overlay->build( this, pos );
       overlay->load( overlayParams );
-      _d->overlayList.push_back( overlay );
+      _d->appendOverlay( overlay );
     }
     else
     {
@@ -580,7 +696,23 @@ void City::load( const VariantMap& stream )
   }
 }
 
-void City::addOverlay( TileOverlayPtr overlay ) { _d->overlayList.push_back( overlay ); }
+void City::addOverlay( TileOverlayPtr overlay ) { _d->appendOverlay( overlay ); }
+
+void City::Impl::appendOverlay( TileOverlayPtr overlay )
+{
+  overlayList.push_back( overlay );
+
+  if( overlay->isAnimated() )
+  {
+    animatedOverlays.push_back( overlay );
+  }
+
+  ConstructionPtr construction = overlay.as<Construction>();
+  if( construction.isValid() )
+  {
+    roadAccessDistance = std::max( roadAccessDistance, construction->getRoadAccessDistance() );
+  }
+}
 
 City::~City(){}
 
@@ -614,6 +746,7 @@ void City::setBuildOptions(const CityBuildOptions& options) { _d->buildOptions =
 const CityWinTargets& City::getWinTargets() const {   return _d->targets; }
 void City::setWinTargets(const CityWinTargets& targets) { _d->targets = targets; }
 TileOverlayPtr City::getOverlay( const TilePos& pos ) const { return _d->tilemap.at( pos ).getOverlay(); }
+int City::getMaxRoadAccessDistance() const { return _d->roadAccessDistance; }
 int City::getLastMonthTax() const { return _d->lastMonthTax; }
 int City::getLastMonthTaxpayer() const { return _d->lastMonthTaxpayer; }
 PlayerPtr City::getPlayer() const { return _d->player; }
@@ -625,10 +758,9 @@ Point City::getLocation() const {   return _d->location; }
 const GoodStore& City::getSells() const {   return _d->tradeOptions.getSells(); }
 const GoodStore& City::getBuys() const {   return _d->tradeOptions.getBuys(); }
 EmpirePtr City::getEmpire() const {   return _d->empire; }
-void City::updateRoads() {    _d->needRecomputeAllRoads = true; }
+void City::updateRoads( const TilePos& pos ) { _d->changedRoads.push_back( pos ); }
 Signal1<int>& City::onPopulationChanged() {  return _d->onPopulationChangedSignal; }
 Signal1<int>& City::onFundsChanged() {  return _d->funds.onChange(); }
-void City::removeWalker( WalkerPtr walker ) { _d->walkerList.remove( walker ); }
 
 int City::getProsperity() const
 {
@@ -658,6 +790,31 @@ void City::resolveMerchantArrived( EmpireMerchantPtr merchant )
   cityMerchant.as<Merchant>()->send2City();
 }
 
+namespace {
+
+void appendDesirability( Tilemap& tilemap, TilePos start, TilePos stop, int value, bool perimeter )
+{
+  for( int i=start.getI(); i <= stop.getI(); i++ )
+  {
+    for( int j=start.getJ(); j <= stop.getJ(); j++ )
+    {
+      bool inside = i > start.getI() && i < stop.getI() && j > start.getJ() && j < stop.getJ();
+      if( perimeter && inside )
+      {
+        j = stop.getJ() - 1;  // jump over interior
+        continue;
+      }
+
+      if( tilemap.isInside( TilePos( i, j ) ) )
+      {
+        tilemap.at( i, j ).appendDesirability( value );
+      }
+    }
+  }
+}
+
+}
+
 void CityHelper::updateDesirability( ConstructionPtr construction, bool onBuild )
 {
   Tilemap& tilemap = _city->getTilemap();
@@ -665,28 +822,103 @@ void CityHelper::updateDesirability( ConstructionPtr construction, bool onBuild
   const MetaData::Desirability dsrbl = construction->getDesirabilityInfo();
   int mul = ( onBuild ? 1 : -1);
 
+  TilePos start = construction->getTilePos();
+  TilePos stop = start + TilePos( construction->getSize().getWidth()-1, construction->getSize().getHeight()-1 );
+
   //change desirability in selfarea
-  TilemapArea area = tilemap.getArea( construction->getTilePos(), construction->getSize() );
-  foreach( Tile* tile, area )
-  {
-    tile->appendDesirability( mul * dsrbl.base );
-  }
+  appendDesirability( tilemap, start, stop, mul * dsrbl.base, false );
 
   //change deisirability around
   int current = mul * dsrbl.base;
   for( int curRange=1; curRange <= dsrbl.range; curRange++ )
   {
-    TilemapArea perimetr = tilemap.getRectangle( construction->getTilePos() - TilePos( curRange, curRange ),
-                                                 construction->getSize() + Size( 2 * curRange ) );
-    foreach( Tile* tile, perimetr )
+    appendDesirability( tilemap, start - TilePos( curRange, curRange ), stop + TilePos( curRange, curRange ),
+                        current, true );
+
+    current += mul * dsrbl.step;
+  }
+}
+
+void CityHelper::rebuildDesirability()
+{
+  Tilemap& tilemap = _city->getTilemap();
+  const int size = tilemap.getSize();
+  const int stride = size + 1;
+
+  // every ring value is a difference of two nested boxes, so each construction
+  // adds O(range) corners to difference table and one prefix sum pass gives the field
+  std::vector< int > delta( stride * stride, 0 );
+
+  TileOverlayList& overlays = _city->getOverlays();
+  foreach( TileOverlayPtr overlay, overlays )
+  {
+    ConstructionPtr construction = overlay.as<Construction>();
+    if( construction.isNull() || construction->isDeleted() )
+      continue;
+
+    const MetaData::Desirability dsrbl = construction->getDesirabilityInfo();
+    TilePos start = construction->getTilePos();
+    TilePos stop = start + TilePos( construction->getSize().getWidth()-1, construction->getSize().getHeight()-1 );
+
+    for( int range=0; range <= dsrbl.range; range++ )
     {
-      tile->appendDesirability( current );
+      // value on ring and on next ring
+      int value = range == 0 ? dsrbl.base : dsrbl.base + (range-1) * dsrbl.step;
+      int nextValue = range < dsrbl.range ? dsrbl.base + range * dsrbl.step : 0;
+      int weight = value - nextValue;
+      if( weight == 0 )
+        continue;
+
+      int i0 = math::clamp( start.getI() - range, 0, size );
+      int j0 = math::clamp( start.getJ() - range, 0, size );
+      int i1 = math::clamp( stop.getI() + range + 1, 0, size );
+      int j1 = math::clamp( stop.getJ() + range + 1, 0, size );
+
+      delta[ i0 * stride + j0 ] += weight;
+      delta[ i0 * stride + j1 ] -= weight;
+      delta[ i1 * stride + j0 ] -= weight;
+      delta[ i1 * stride + j1 ] += weight;
     }
+  }
 
-    current += mul * dsrbl.step;
+  for( int i=0; i < size; i++ )
+  {
+    for( int j=0; j < size; j++ )
+    {
+      int value = delta[ i * stride + j ];
+      if( i > 0 ) { value += delta[ (i-1) * stride + j ]; }
+      if( j > 0 ) { value += delta[ i * stride + j - 1 ]; }
+      if( i > 0 && j > 0 ) { value -= delta[ (i-1) * stride + j - 1 ]; }
+      delta[ i * stride + j ] = value;
+
+      tilemap.at( i, j ).setDesirability( value );
+    }
   }
 }
 
+int CityHelper::getDesirability( const TilePos& start, const Size& size )
+{
+  Tilemap& tilemap = _city->getTilemap();
+  TilePos stop = start + TilePos( size.getWidth()-1, size.getHeight()-1 );
+
+  bool first = true;
+  float ret = 0;
+  for( int i=start.getI(); i <= stop.getI(); i++ )
+  {
+    for( int j=start.getJ(); j <= stop.getJ(); j++ )
+    {
+      if( !tilemap.isInside( TilePos( i, j ) ) )
+        continue;
+
+      float value = (float)tilemap.at( i, j ).getDesirability();
+      ret = first ? value : (ret + value) / 2.f;
+      first = false;
+    }
+  }
+
+  return (int)ret;
+}
+
 TilemapArea CityHelper::getArea(TileOverlayPtr overlay)
 {
   return _city->getTilemap().getArea( overlay->getTilePos(), overlay->getSize() );
@@ -38,6 +38,7 @@ class CityBuildOptions;
 class CityTradeOptions;
 class CityWinTargets;
 class CityFunds;
+class Random;
 
 struct BorderInfo
 {
@@ -61,13 +62,15 @@ public:
   WalkerList getWalkers( constants::walker::Type type );
   WalkerList getWalkers( constants::walker::Type type, TilePos startPos, TilePos stopPos=TilePos( -1, -1 ) );
   void addWalker( WalkerPtr walker );
-  void removeWalker( WalkerPtr walker );
 
   void addService( CityServicePtr service );
   CityServicePtr findService( const std::string& name ) const;
 
   TileOverlayList& getOverlays();
 
+  // overlays which have animation, renderer advances only visible ones of them
+  TileOverlayList& getAnimatedOverlays();
+
   void setBorderInfo( const BorderInfo& info );
   const BorderInfo& getBorderInfo() const;
 
@@ -84,12 +87,18 @@ public:
 
   CityFunds& getFunds() const;
 
+  // simulation draws random values from here, state is saved with city
+  Random& getRandom();
+
   int getPopulation() const;
   int getProsperity() const;
   int getCulture() const;
 
   Tilemap& getTilemap();
 
+  // position and movement of city walkers, see WalkerKinematics
+  WalkerKinematicsPtr getWalkerKinematics() const;
+
   std::string getName() const; 
   void setName( const std::string& name );
 
@@ -116,7 +125,11 @@ public:
 
   virtual EmpirePtr getEmpire() const;
 
-  void updateRoads();
+  void updateRoads( const TilePos& pos );
+
+  // largest road access distance of constructions, road tile farther than it
+  // from a building never serves the building
+  int getMaxRoadAccessDistance() const;
    
 oc3_signals public:
   Signal1<int>& onPopulationChanged();
@@ -275,6 +288,12 @@ public:
 
   void updateDesirability( ConstructionPtr construction, bool onBuild );
 
+  // recompute desirability of whole map from all constructions, for loaders
+  void rebuildDesirability();
+
+  // running average of desirability in area, as house level check counts it
+  int getDesirability( const TilePos& start, const Size& size );
+
 protected:
   CityPtr _city;
 };
@@ -20,6 +20,7 @@
 #include "tilemap.hpp"
 #include "walker/animals.hpp"
 #include "walker/constants.hpp"
+#include "core/random.hpp"
 
 using namespace constants;
 
@@ -70,7 +71,7 @@ void CityServiceAnimals::update(const unsigned int time)
       if( sheep.isValid() )
       {
         TilemapTiles::iterator it = border.begin();
-        std::advance( it, std::rand() % border.size() );
+        std::advance( it, _d->city->getRandom().get() % border.size() );
         sheep.as<Sheep>()->send2City( (*it)->getIJ() );
       }
     }
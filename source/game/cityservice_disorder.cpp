@@ -17,6 +17,7 @@
 #include "city.hpp"
 #include "building/constants.hpp"
 #include "core/foreach.hpp"
+#include "core/random.hpp"
 #include "building/house.hpp"
 #include "walker/protestor.hpp"
 
@@ -61,7 +62,7 @@ void CityServiceDisorder::update( const unsigned int time )
   HouseList criminalizedHouse;
   foreach( HousePtr house, houses )
   {
-    int crimeLvl = rand() % (house->getServiceValue( Service::crime )+1);
+    int crimeLvl = _d->city->getRandom().get() % (house->getServiceValue( Service::crime )+1);
     if( crimeLvl >= _d->minCrimeLevel )
     {
       criminalizedHouse.push_back( house );
@@ -71,7 +72,7 @@ void CityServiceDisorder::update( const unsigned int time )
   if( criminalizedHouse.size() > walkers.size() )
   {
     HouseList::iterator it = criminalizedHouse.begin();
-    std::advance( it, rand() % criminalizedHouse.size() );
+    std::advance( it, _d->city->getRandom().get() % criminalizedHouse.size() );
     (*it)->appendServiceValue( Service::crime, -defaultCrimeLevel / 2 );
 
     ProtestorPtr protestor = Protestor::create( _d->city );
@@ -19,6 +19,7 @@
 #include "tilemap.hpp"
 #include "walker/emigrant.hpp"
 #include "core/position.hpp"
+#include "core/random.hpp"
 #include "road.hpp"
 #include "building/house.hpp"
 #include "gfx/tile.hpp"
@@ -63,7 +64,7 @@ void CityServiceEmigrant::update( const unsigned int time )
   int worklessPercent = CityStatistic::getWorklessPercent( _d->city );
   emigrantsDesirability += worklessPercent;
 
-  int goddesRandom = rand() % 100;
+  int goddesRandom = _d->city->getRandom().get() % 100;
   if( goddesRandom > emigrantsDesirability )
     return;
 
@@ -0,0 +1,88 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "cityservice_firerisk.hpp"
+#include "city.hpp"
+#include "construction.hpp"
+#include "core/math.hpp"
+#include <map>
+
+class CityServiceFireRisk::Impl
+{
+public:
+  typedef std::map< unsigned int, Construction* > Items;  // key=tile position
+
+  Items buckets[ bucketCount ];
+
+  static unsigned int key( const TilePos& pos ) { return ( pos.getI() << 16 ) + pos.getJ(); }
+};
+
+CityServicePtr CityServiceFireRisk::create( CityPtr city )
+{
+  CityServicePtr ret( new CityServiceFireRisk( city ) );
+  ret->drop();
+
+  return ret;
+}
+
+std::string CityServiceFireRisk::getDefaultName()
+{
+  return "fireRisk";
+}
+
+int CityServiceFireRisk::getBucket( double fireLevel )
+{
+  return math::clamp<int>( (int)fireLevel / 10, 0, bucketCount-1 );
+}
+
+CityServiceFireRisk::CityServiceFireRisk( CityPtr city )
+: CityService( getDefaultName() ), _d( new Impl )
+{
+}
+
+void CityServiceFireRisk::update( const unsigned int time )
+{
+}
+
+void CityServiceFireRisk::move( Construction* item, const TilePos& pos, int from, int to )
+{
+  if( from == to )
+    return;
+
+  if( from != noBucket ) { _d->buckets[ from ].erase( Impl::key( pos ) ); }
+  if( to != noBucket ) { _d->buckets[ to ][ Impl::key( pos ) ] = item; }
+}
+
+ConstructionList CityServiceFireRisk::find( double minLevel ) const
+{
+  ConstructionList ret;
+  for( int i=bucketCount-1; i >= getBucket( minLevel ); i-- )
+  {
+    const Impl::Items& items = _d->buckets[ i ];
+    for( Impl::Items::const_iterator it=items.begin(); it != items.end(); it++ )
+    {
+      if( it->second->getState( Construction::fire ) >= minLevel )
+      {
+        ret.push_back( it->second );
+      }
+    }
+  }
+
+  return ret;
+}
+
+CityServiceFireRisk::~CityServiceFireRisk()
+{
+}
@@ -0,0 +1,53 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __OPENCAESAR3_CITYSERVICE_FIRERISK_H_INCLUDED__
+#define __OPENCAESAR3_CITYSERVICE_FIRERISK_H_INCLUDED__
+
+#include "cityservice.hpp"
+#include "core/scopedptr.hpp"
+#include "core/predefinitions.hpp"
+#include "core/position.hpp"
+
+// built constructions grouped by fire level with 10% step, so prefects
+// find risky buildings without scanning the overlay list
+class CityServiceFireRisk : public CityService
+{
+public:
+  enum { bucketCount=11, noBucket=-1 };
+
+  static CityServicePtr create( CityPtr city );
+  static std::string getDefaultName();
+
+  static int getBucket( double fireLevel );
+
+  void update( const unsigned int time );
+
+  // construction at pos changed its bucket, noBucket adds or removes it
+  void move( Construction* item, const TilePos& pos, int from, int to );
+
+  // constructions with fire level not less than minLevel, riskiest bucket
+  // first, inside bucket ordered by position, so result is same on every run
+  ConstructionList find( double minLevel ) const;
+
+  ~CityServiceFireRisk();
+private:
+  CityServiceFireRisk( CityPtr city );
+
+  class Impl;
+  ScopedPtr< Impl > _d;
+};
+
+#endif //__OPENCAESAR3_CITYSERVICE_FIRERISK_H_INCLUDED__
@@ -15,16 +15,92 @@
 
 #include "cityservice_timers.hpp"
 #include "core/time.hpp"
+#include "core/logger.hpp"
+#include "core/foreach.hpp"
 #include <vector>
+#include <algorithm>
 
 typedef std::vector< TimerPtr > Timers;
 
+// timing wheel: timer lives in slot of its due time, so update
+// touches only timers which fire now or are later by whole wheel turns
 class CityServiceTimers::Impl
 {
 public:
-  Timers timers;
+  enum { wheelSize=256 };
+
+  struct Entry
+  {
+    TimerPtr timer;
+    unsigned int due;
+  };
+
+  typedef std::vector< Entry > Slot;
+
+  Slot wheel[ wheelSize ];
+  Timers pending;
+  unsigned int lastTime;
+  bool isStarted;
+  unsigned int dueCount;
+  unsigned int peakDueCount;
+
+  void schedule( TimerPtr timer )
+  {
+    Entry entry;
+    entry.timer = timer;
+    entry.due = timer->getDueTime();
+    wheel[ entry.due % wheelSize ].push_back( entry );
+  }
+
+  void updateSlot( Slot& slot, unsigned int time, Timers& fired );
+  void restart();
 };
 
+void CityServiceTimers::Impl::restart()
+{
+  for( int i=0; i < wheelSize; i++ )
+  {
+    for( Slot::iterator it=wheel[ i ].begin(); it != wheel[ i ].end(); it++ )
+    {
+      if( it->timer->isActive() && it->due == it->timer->getDueTime() )
+      {
+        it->timer->restart();
+        pending.push_back( it->timer );
+      }
+    }
+
+    wheel[ i ].clear();
+  }
+}
+
+void CityServiceTimers::Impl::updateSlot( Slot& slot, unsigned int time, Timers& fired )
+{
+  Slot::iterator it=slot.begin();
+  while( it != slot.end() )
+  {
+    // timer was stopped or moved to another slot by setTime()
+    if( !it->timer->isActive() || it->due != it->timer->getDueTime() )
+    {
+      it = slot.erase( it );
+    }
+    else if( it->due > time )
+    {
+      it++;  // fires on one of next wheel turns
+    }
+    else
+    {
+      dueCount++;
+      it->timer->update( time );
+      if( it->timer->isActive() )
+      {
+        fired.push_back( it->timer );
+      }
+
+      it = slot.erase( it );
+    }
+  }
+}
+
 CityServiceTimers& CityServiceTimers::getInstance()
 {
   static CityServiceTimers inst;
@@ -34,28 +110,84 @@ CityServiceTimers& CityServiceTimers::getInstance()
 CityServiceTimers::CityServiceTimers() 
   : CityService( "timers" ), _d( new Impl )
 { 
+  _d->lastTime = 0;
+  _d->isStarted = false;
+  _d->dueCount = 0;
+  _d->peakDueCount = 0;
 }
 
 void CityServiceTimers::update( const unsigned int time )
 {
-  Timers::iterator it=_d->timers.begin(); 
-  while( it != _d->timers.end() )
-  { 
-    if( !(*it)->isActive() )
-    {
-      it = _d->timers.erase( it );      
-    }
-    else
+  _d->dueCount = 0;
+
+  if( _d->isStarted && time < _d->lastTime )
+  {
+    // game time was reset, scheduled timers count again from current tick
+    _d->restart();
+  }
+
+  // new timers start counting from current tick, like Timer::update does
+  Timers pending;
+  pending.swap( _d->pending );
+  foreach( TimerPtr timer, pending )
+  {
+    timer->update( time );
+    if( timer->isActive() )
     {
-      (*it)->update( time );
-      it++;
+      _d->schedule( timer );
     }
   }
+
+  if( !_d->isStarted || time < _d->lastTime )
+  {
+    // first tick or time reset, check every slot once
+    _d->lastTime = time - Impl::wheelSize;
+    _d->isStarted = true;
+  }
+
+  // game time can step over several ticks
+  unsigned int steps = std::min<unsigned int>( time - _d->lastTime, Impl::wheelSize );
+  Timers fired;
+  for( unsigned int i=0; i < steps; i++ )
+  {
+    _d->updateSlot( _d->wheel[ ( time - i ) % Impl::wheelSize ], time, fired );
+  }
+  _d->lastTime = time;
+
+  // looped timers go to their next slots
+  foreach( TimerPtr timer, fired )
+  {
+    _d->schedule( timer );
+  }
+
+  _d->peakDueCount = std::max( _d->peakDueCount, _d->dueCount );
 }
 
 void CityServiceTimers::addTimer( TimerPtr timer )
 {
-  _d->timers.push_back( timer );
+  _d->pending.push_back( timer );
+}
+
+unsigned int CityServiceTimers::getDueCount() const
+{
+  return _d->dueCount;
+}
+
+unsigned int CityServiceTimers::getPeakDueCount() const
+{
+  return _d->peakDueCount;
+}
+
+void CityServiceTimers::printStatistic() const
+{
+  unsigned int scheduled = _d->pending.size();
+  for( int i=0; i < Impl::wheelSize; i++ )
+  {
+    scheduled += _d->wheel[ i ].size();
+  }
+
+  Logger::warning( "Timers: scheduled %d, fired on last tick %d, peak per tick %d",
+                   scheduled, _d->dueCount, _d->peakDueCount );
 }
 
 CityServiceTimers::~CityServiceTimers()
@@ -27,6 +27,11 @@ public:
   void update( const unsigned int time );
   void addTimer( TimerPtr timer );
 
+  // timers updated on last tick and the most on one tick
+  unsigned int getDueCount() const;
+  unsigned int getPeakDueCount() const;
+  void printStatistic() const;
+
   ~CityServiceTimers();
 private:
   CityServiceTimers();
@@ -0,0 +1,383 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "cityservice_vacancies.hpp"
+#include "city.hpp"
+#include "tilemap.hpp"
+#include "pathway.hpp"
+#include "building/house.hpp"
+#include "building/constants.hpp"
+#include "core/random.hpp"
+#include "core/foreach.hpp"
+#include <vector>
+#include <map>
+
+using namespace constants;
+
+class CityServiceVacancies::Impl
+{
+public:
+  typedef std::vector< House* > Houses;
+  struct Slot
+  {
+    int component;
+    unsigned int index;
+  };
+
+  CityPtr city;
+  bool changed;
+  int size;
+  int entryComponent;
+
+  std::vector< int > components;  // road network of tile, -1 if tile isn't road
+  std::vector< int > distances;   // steps from road entry, -1 if not reachable
+  std::vector< int > parents;     // previous tile on the way from road entry
+
+  std::map< int, Houses > vacant;
+  std::map< House*, Slot > slots;
+
+  int index( int i, int j ) const { return i * size + j; }
+  Tile& tile( int index ) { return city->getTilemap().at( index / size, index % size ); }
+
+  void rebuild();
+  void updateRoads();
+  void markComponent( int start, int component, bool fromEntry );
+  int getRoadIndex( const TilePos& pos );
+  int getHouseComponent( House* house, int* road=0 );
+  bool isVacant( House* house );
+  void updateHouse( House* house );
+  void append( House* house, int component );
+  void remove( House* house );
+  void buildWay( int from, int to, Pathway& way );
+};
+
+CityServicePtr CityServiceVacancies::create( CityPtr city )
+{
+  CityServicePtr ret( new CityServiceVacancies( city ) );
+  ret->drop();
+
+  return ret;
+}
+
+std::string CityServiceVacancies::getDefaultName()
+{
+  return "vacancies";
+}
+
+CityServiceVacancies::CityServiceVacancies( CityPtr city )
+: CityService( getDefaultName() ), _d( new Impl )
+{
+  _d->city = city;
+  _d->changed = true;
+  _d->size = 0;
+  _d->entryComponent = -1;
+}
+
+void CityServiceVacancies::update( const unsigned int time )
+{
+  if( _d->changed )
+  {
+    _d->rebuild();
+  }
+}
+
+void CityServiceVacancies::invalidate()
+{
+  _d->changed = true;
+}
+
+void CityServiceVacancies::updateHouse( House* house )
+{
+  // whole index will be rebuilt, nothing to update now
+  if( !_d->changed )
+  {
+    _d->updateHouse( house );
+  }
+}
+
+void CityServiceVacancies::removeHouse( House* house )
+{
+  _d->remove( house );
+}
+
+HousePtr CityServiceVacancies::findHouse( const TilePos& start, Pathway& way )
+{
+  if( _d->changed )
+  {
+    _d->rebuild();
+  }
+
+  int startRoad = _d->getRoadIndex( start );
+  int component = startRoad >= 0 ? _d->components[ startRoad ] : _d->entryComponent;
+
+  std::map< int, Impl::Houses >::iterator it = _d->vacant.find( component );
+  if( it == _d->vacant.end() )
+  {
+    return HousePtr();
+  }
+
+  // entries become stale when house was filled without notification,
+  // drop them while looking for a really vacant one
+  Impl::Houses& houses = it->second;
+  while( !houses.empty() )
+  {
+    House* house = houses[ _d->city->getRandom().get() % houses.size() ];
+
+    int road = -1;
+    if( !_d->isVacant( house ) || _d->getHouseComponent( house, &road ) != component )
+    {
+      _d->remove( house );
+      continue;
+    }
+
+    // road tree is built by wave from the entry, so only a way from the entry
+    // is shortest; walkers started elsewhere search their way themselves
+    bool startOnRoad = (startRoad == _d->index( start.getI(), start.getJ() ));
+    if( startOnRoad && _d->distances[ startRoad ] == 0 )
+    {
+      _d->buildWay( startRoad, road, way );
+    }
+
+    return HousePtr( house );
+  }
+
+  return HousePtr();
+}
+
+CityServiceVacancies::~CityServiceVacancies()
+{
+
+}
+
+void CityServiceVacancies::Impl::rebuild()
+{
+  changed = false;
+  vacant.clear();
+  slots.clear();
+
+  updateRoads();
+
+  CityHelper helper( city );
+  HouseList houses = helper.find<House>( building::house );
+  foreach( HousePtr house, houses )
+  {
+    updateHouse( house.object() );
+  }
+}
+
+void CityServiceVacancies::Impl::updateRoads()
+{
+  Tilemap& tilemap = city->getTilemap();
+  size = tilemap.getSize();
+
+  int count = size * size;
+  components.assign( count, -1 );
+  distances.assign( count, -1 );
+  parents.assign( count, -1 );
+
+  // network of the entry is marked first, only it has distances
+  int componentsCount = 0;
+  entryComponent = -1;
+  TilePos entry = city->getBorderInfo().roadEntry;
+  if( tilemap.isInside( entry ) && tilemap.at( entry ).getFlag( Tile::tlRoad ) )
+  {
+    entryComponent = componentsCount++;
+    markComponent( index( entry.getI(), entry.getJ() ), entryComponent, true );
+  }
+
+  for( int k=0; k < count; k++ )
+  {
+    if( components[ k ] < 0 && tile( k ).getFlag( Tile::tlRoad ) )
+    {
+      markComponent( k, componentsCount++, false );
+    }
+  }
+}
+
+void CityServiceVacancies::Impl::markComponent( int start, int component, bool fromEntry )
+{
+  static const int di[ 4 ] = { -1, 1, 0, 0 };
+  static const int dj[ 4 ] = { 0, 0, -1, 1 };
+
+  std::vector< int > wave( 1, start );
+  components[ start ] = component;
+  distances[ start ] = fromEntry ? 0 : -1;
+
+  for( unsigned int head=0; head < wave.size(); head++ )
+  {
+    int current = wave[ head ];
+    int i = current / size;
+    int j = current % size;
+
+    for( int k=0; k < 4; k++ )
+    {
+      int ni = i + di[ k ];
+      int nj = j + dj[ k ];
+      if( ni < 0 || nj < 0 || ni >= size || nj >= size )
+        continue;
+
+      int next = index( ni, nj );
+      if( components[ next ] >= 0 || !tile( next ).getFlag( Tile::tlRoad ) )
+        continue;
+
+      components[ next ] = component;
+      if( fromEntry )
+      {
+        distances[ next ] = distances[ current ] + 1;
+        parents[ next ] = current;
+      }
+
+      wave.push_back( next );
+    }
+  }
+}
+
+int CityServiceVacancies::Impl::getRoadIndex( const TilePos& pos )
+{
+  // walker can stand on road or leave building, which is not far than
+  // its road access distance from road
+  const int maxRoadAccessDistance = city->getMaxRoadAccessDistance();
+
+  if( pos.getI() < 0 || pos.getJ() < 0 || pos.getI() >= size || pos.getJ() >= size )
+    return -1;
+
+  int ret = index( pos.getI(), pos.getJ() );
+  if( components[ ret ] >= 0 )
+    return ret;
+
+  for( int i=pos.getI() - maxRoadAccessDistance; i <= pos.getI() + maxRoadAccessDistance; i++ )
+  {
+    for( int j=pos.getJ() - maxRoadAccessDistance; j <= pos.getJ() + maxRoadAccessDistance; j++ )
+    {
+      if( i >= 0 && j >= 0 && i < size && j < size && components[ index( i, j ) ] >= 0 )
+        return index( i, j );
+    }
+  }
+
+  return -1;
+}
+
+int CityServiceVacancies::Impl::getHouseComponent( House* house, int* road )
+{
+  // prefer access road nearest to the entry, then any road network
+  int component = -1;
+  int bestRoad = -1;
+
+  const TilemapTiles& roads = house->getAccessRoads();
+  for( TilemapTiles::const_iterator it=roads.begin(); it != roads.end(); it++ )
+  {
+    int current = index( (*it)->getI(), (*it)->getJ() );
+    if( current >= (int)components.size() || components[ current ] < 0 )
+      continue;
+
+    bool nearer = distances[ current ] >= 0
+                  && (bestRoad < 0 || distances[ bestRoad ] < 0 || distances[ current ] < distances[ bestRoad ]);
+
+    if( bestRoad < 0 || nearer )
+    {
+      bestRoad = current;
+      component = components[ current ];
+    }
+  }
+
+  if( road )
+  {
+    *road = bestRoad;
+  }
+
+  return component;
+}
+
+bool CityServiceVacancies::Impl::isVacant( House* house )
+{
+  return !house->isDeleted() && house->getHabitants().count() < house->getMaxHabitants();
+}
+
+void CityServiceVacancies::Impl::updateHouse( House* house )
+{
+  int component = isVacant( house ) ? getHouseComponent( house ) : -1;
+
+  std::map< House*, Slot >::iterator it = slots.find( house );
+  if( it != slots.end() )
+  {
+    if( it->second.component == component )
+      return;
+
+    remove( house );
+  }
+
+  if( component >= 0 )
+  {
+    append( house, component );
+  }
+}
+
+void CityServiceVacancies::Impl::append( House* house, int component )
+{
+  Houses& houses = vacant[ component ];
+
+  Slot slot;
+  slot.component = component;
+  slot.index = houses.size();
+
+  slots[ house ] = slot;
+  houses.push_back( house );
+}
+
+void CityServiceVacancies::Impl::remove( House* house )
+{
+  std::map< House*, Slot >::iterator it = slots.find( house );
+  if( it == slots.end() )
+    return;
+
+  // move last house to the freed place
+  Houses& houses = vacant[ it->second.component ];
+  House* last = houses.back();
+  houses[ it->second.index ] = last;
+  slots[ last ].index = it->second.index;
+  houses.pop_back();
+
+  slots.erase( house );
+}
+
+void CityServiceVacancies::Impl::buildWay( int from, int to, Pathway& way )
+{
+  // go up on the entry tree from both ends until they meet,
+  // it is shortest way only when one of ends is the entry
+  std::vector< int > head;
+  std::vector< int > tail;
+  while( from != to )
+  {
+    if( distances[ from ] >= distances[ to ] )
+    {
+      head.push_back( from );
+      from = parents[ from ];
+    }
+    else
+    {
+      tail.push_back( to );
+      to = parents[ to ];
+    }
+  }
+
+  head.push_back( from );
+  head.insert( head.end(), tail.rbegin(), tail.rend() );
+
+  way.init( city->getTilemap(), tile( head.front() ) );
+  for( unsigned int k=1; k < head.size(); k++ )
+  {
+    way.setNextTile( tile( head[ k ] ) );
+  }
+}
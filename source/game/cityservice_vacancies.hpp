@@ -0,0 +1,55 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __OPENCAESAR3_CITYSERVICE_VACANCIES_H_INCLUDED__
+#define __OPENCAESAR3_CITYSERVICE_VACANCIES_H_INCLUDED__
+
+#include "cityservice.hpp"
+#include "core/scopedptr.hpp"
+#include "core/predefinitions.hpp"
+#include "core/position.hpp"
+
+class Pathway;
+
+// vacant houses grouped by road network component, with distances from
+// the road entry, so immigrants get a reachable house without full search
+class CityServiceVacancies : public CityService
+{
+public:
+  static CityServicePtr create( CityPtr city );
+  static std::string getDefaultName();
+
+  void update( const unsigned int time );
+
+  // roads or road entry were changed, road graph is rebuilt on next request
+  void invalidate();
+
+  // house habitants, level or access roads were changed
+  void updateHouse( House* house );
+  void removeHouse( House* house );
+
+  // returns random vacant house which can be reached by road from start,
+  // way is filled when start is the road entry
+  HousePtr findHouse( const TilePos& start, Pathway& way );
+
+  ~CityServiceVacancies();
+private:
+  CityServiceVacancies( CityPtr city );
+
+  class Impl;
+  ScopedPtr< Impl > _d;
+};
+
+#endif //__OPENCAESAR3_CITYSERVICE_VACANCIES_H_INCLUDED__
@@ -15,11 +15,32 @@
 
 #include "cityservice_water.hpp"
 #include "city.hpp"
+#include "building/watersupply.hpp"
+#include "building/constants.hpp"
+#include "core/foreach.hpp"
+#include "game/tilemap.hpp"
+#include "gfx/tile.hpp"
+#include <set>
+
+using namespace constants;
 
 class CityServiceWater::Impl
 {
 public:
+  typedef std::set< WaterSource* > Reached;
+
   CityPtr city;
+
+  // reservoir near water feeds its network by itself
+  bool isSpring( WaterSourcePtr ws ) const;
+
+  // sources which have ws in their outlets
+  WaterSourceList getInlets( WaterSourcePtr ws ) const;
+
+  // walks outlets from wave, takes sources with given water state,
+  // only from area when it is set and never the skipped one
+  void flood( WaterSourceList& wave, Reached& reached, bool haveWater,
+              const Reached* area, WaterSource* skip ) const;
 };
 
 CityServicePtr CityServiceWater::create( CityPtr city )
@@ -29,16 +50,162 @@ CityServicePtr CityServiceWater::create( CityPtr city )
   return CityServicePtr( ret );
 }
 
+std::string CityServiceWater::getDefaultName()
+{
+  return "water";
+}
+
 CityServiceWater::CityServiceWater( CityPtr city )
-: CityService( "water" ), _d( new Impl )
+: CityService( getDefaultName() ), _d( new Impl )
 {
   _d->city = city;
 }
 
 void CityServiceWater::update( const unsigned int time )
 {
-  if( time % 22 != 1 )
+  // network state changes only with topology, nothing to do on static network
+}
+
+void CityServiceWater::addSource( WaterSourcePtr source )
+{
+  if( source->haveWater() )
+    return;
+
+  bool fed = _d->isSpring( source );
+  if( !fed )
+  {
+    WaterSourceList inlets = _d->getInlets( source );
+    foreach( WaterSourcePtr inlet, inlets )
+    {
+      if( inlet->haveWater() )
+      {
+        fed = true;
+        break;
+      }
+    }
+  }
+
+  if( !fed )
+    return;
+
+  // new source joins watered network, water goes on to the dry part behind it
+  Impl::Reached reached;
+  WaterSourceList wave;
+  reached.insert( source.object() );
+  wave.push_back( source );
+  _d->flood( wave, reached, false, 0, 0 );
+
+  foreach( WaterSource* ws, reached )
+  {
+    ws->setHaveWater( true );
+  }
+}
+
+void CityServiceWater::removeSource( WaterSourcePtr source )
+{
+  // dry source carried no water, nothing depends on it
+  if( !source->haveWater() )
     return;
 
-  //unsigned int vacantPop=0;
+  // watered sources downstream of removed one may have lost their feed
+  Impl::Reached affected;
+  WaterSourceList wave;
+  WaterSourceList outlets = source->getOutlets();
+  foreach( WaterSourcePtr outlet, outlets )
+  {
+    if( outlet != source && !outlet->isDeleted() && outlet->haveWater()
+        && affected.insert( outlet.object() ).second )
+    {
+      wave.push_back( outlet );
+    }
+  }
+  _d->flood( wave, affected, true, 0, source.object() );
+
+  // re-flood affected part from springs inside it and from watered sources around it
+  Impl::Reached reached;
+  foreach( WaterSource* ws, affected )
+  {
+    WaterSourcePtr current( ws );
+    bool fed = _d->isSpring( current );
+
+    WaterSourceList inlets = fed ? WaterSourceList() : _d->getInlets( current );
+    foreach( WaterSourcePtr inlet, inlets )
+    {
+      if( inlet != source && inlet->haveWater() && affected.count( inlet.object() ) == 0 )
+      {
+        fed = true;
+        break;
+      }
+    }
+
+    if( fed && reached.insert( ws ).second )
+    {
+      wave.push_back( current );
+    }
+  }
+  _d->flood( wave, reached, true, &affected, source.object() );
+
+  foreach( WaterSource* ws, affected )
+  {
+    ws->setHaveWater( reached.count( ws ) > 0 );
+  }
+}
+
+bool CityServiceWater::Impl::isSpring( WaterSourcePtr ws ) const
+{
+  ReservoirPtr reservoir = ws.as<Reservoir>();
+  return reservoir.isValid() && reservoir->isNearWater();
+}
+
+WaterSourceList CityServiceWater::Impl::getInlets( WaterSourcePtr ws ) const
+{
+  WaterSourceList ret;
+  Reached checked;
+
+  TilemapArea perimetr = city->getTilemap().getRectangle( ws->getTilePos() - TilePos( 1, 1 ),
+                                                          ws->getSize() + Size( 2 ),
+                                                          !Tilemap::checkCorners );
+  foreach( Tile* tile, perimetr )
+  {
+    WaterSourcePtr neighbour = tile->getOverlay().as<WaterSource>();
+    if( neighbour.isNull() || neighbour->isDeleted() || !checked.insert( neighbour.object() ).second )
+      continue;
+
+    WaterSourceList outlets = neighbour->getOutlets();
+    foreach( WaterSourcePtr outlet, outlets )
+    {
+      if( outlet == ws )
+      {
+        ret.push_back( neighbour );
+        break;
+      }
+    }
+  }
+
+  return ret;
+}
+
+void CityServiceWater::Impl::flood( WaterSourceList& wave, Reached& reached, bool haveWater,
+                                    const Reached* area, WaterSource* skip ) const
+{
+  while( !wave.empty() )
+  {
+    WaterSourcePtr ws = wave.front();
+    wave.pop_front();
+
+    WaterSourceList outlets = ws->getOutlets();
+    foreach( WaterSourcePtr outlet, outlets )
+    {
+      if( outlet.object() == skip || outlet->isDeleted() || outlet->haveWater() != haveWater )
+        continue;
+
+      if( area && area->count( outlet.object() ) == 0 )
+        continue;
+
+      if( reached.insert( outlet.object() ).second )
+      {
+        wave.push_back( outlet );
+      }
+    }
+  }
 }
@@ -24,8 +24,15 @@ class CityServiceWater : public CityService
 {
 public:
   static CityServicePtr create( CityPtr city );
+  static std::string getDefaultName();
 
   void update( const unsigned int time );
+
+  // source was built, water floods into it at once when a neighbour feeds it
+  void addSource( WaterSourcePtr source );
+
+  // source is destroyed, only sources which could take water through it are re-flooded
+  void removeSource( WaterSourcePtr source );
 private:
   CityServiceWater( CityPtr city );
 
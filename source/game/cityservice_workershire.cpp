@@ -21,6 +21,8 @@
 #include "walker/workerhunter.hpp"
 #include "core/foreach.hpp"
 #include "building/constants.hpp"
+#include "timer.hpp"
+#include "core/logger.hpp"
 #include <map>
 
 using namespace constants;
@@ -34,6 +36,7 @@ public:
   Priorities priorities;
   WalkerList hrInCity;
   CityPtr city;
+  TimerPtr hireTimer;
 };
 
 CityServicePtr CityServiceWorkersHire::create( CityPtr city )
@@ -79,6 +82,14 @@ CityServiceWorkersHire::CityServiceWorkersHire( CityPtr city )
   _d->priorities[ 29 ] = building::amphitheater;
   _d->priorities[ 30 ] = building::gladiatorSchool;
   _d->priorities[ 31 ] = building::wharf;
+
+  _d->hireTimer = Timer::createPeriodic( 22, 1 );
+  CONNECT( _d->hireTimer, onTimeout(), this, CityServiceWorkersHire::_hire );
+}
+
+CityServiceWorkersHire::~CityServiceWorkersHire()
+{
+  _d->hireTimer->destroy();
 }
 
 bool CityServiceWorkersHire::_haveHr( WorkingBuildingPtr building )
@@ -116,9 +127,11 @@ void CityServiceWorkersHire::_hireByType(const TileOverlay::Type type )
 
 void CityServiceWorkersHire::update( const unsigned int time )
 {
-  if( time % 22 != 1 )
-    return;
+  // hiring is done by timer, see _hire()
+}
 
+void CityServiceWorkersHire::_hire()
+{
   //unsigned int vacantPop=0;
 
   _d->hrInCity = _d->city->getWalkers( walker::recruter );
@@ -27,9 +27,13 @@ public:
   static CityServicePtr create( CityPtr city );
 
   void update( const unsigned int time );
+
+  ~CityServiceWorkersHire();
 private:
   CityServiceWorkersHire( CityPtr city );
 
+  void _hire();
+
   void _hireByType( const TileOverlay::Type type );
   bool _haveHr( WorkingBuildingPtr building );
  
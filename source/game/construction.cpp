@@ -20,15 +20,52 @@
 #include "gfx/tile.hpp"
 #include "game/tilemap.hpp"
 #include "game/city.hpp"
+#include "game/cityservice_firerisk.hpp"
 #include "events/event.hpp"
 #include "core/logger.hpp"
 
 class Construction::Impl
 {
 public:
-  typedef std::map<Construction::Param, double> Params;
+  typedef enum { noIntent=0, collapseIntent, burnIntent } Intent;
+
   TilemapTiles accessRoads;
-  Params params;
+  double params[ Construction::paramCount ];
+  SmartPtr< CityServiceFireRisk > fireRisk;  // set while construction is built
+  TilePos fireRiskPos;
+  int fireBucket;
+  Intent intent;  // computed by think(), applied by next timeStep()
+
+  void appendAccessRoad( Tilemap& tilemap, const TilePos& pos )
+  {
+    if( tilemap.isInside( pos ) )
+    {
+      Tile& tile = tilemap.at( pos );
+      if( tile.getFlag( Tile::tlRoad ) )
+      {
+        accessRoads.push_back( &tile );
+      }
+    }
+  }
+
+  void setParam( Construction* owner, Param param, double value )
+  {
+    params[ param ] = value;
+    if( param == fire && fireRisk.isValid() )
+    {
+      updateFireRisk( owner, CityServiceFireRisk::getBucket( value ) );
+    }
+  }
+
+  void updateFireRisk( Construction* owner, int bucket )
+  {
+    if( fireRisk.isValid() )
+    {
+      fireRisk->move( owner, fireRiskPos, fireBucket, bucket );
+    }
+
+    fireBucket = bucket;
+  }
 };
 
 Construction::Construction(const Type type, const Size& size)
@@ -36,11 +73,13 @@ Construction::Construction(const Type type, const Size& size)
 {
   _d->params[ fire ] = 0;
   _d->params[ damage ] = 0;
+  _d->fireBucket = CityServiceFireRisk::noBucket;
+  _d->intent = Impl::noIntent;
 }
 
 Construction::~Construction()
 {
-
+  _d->updateFireRisk( this, CityServiceFireRisk::noBucket );
 }
 
 bool Construction::canBuild( CityPtr city, const TilePos& pos ) const
@@ -70,6 +109,11 @@ void Construction::build( CityPtr city, const TilePos& pos )
 {
   TileOverlay::build( city, pos );
 
+  _d->updateFireRisk( this, CityServiceFireRisk::noBucket );
+  _d->fireRisk = city->findService( CityServiceFireRisk::getDefaultName() ).as<CityServiceFireRisk>();
+  _d->fireRiskPos = pos;
+  _d->updateFireRisk( this, CityServiceFireRisk::getBucket( _d->params[ fire ] ) );
+
   computeAccessRoads();
 }
 
@@ -89,15 +133,22 @@ void Construction::computeAccessRoads()
 
   Tilemap& tilemap = _getCity()->getTilemap();
 
+  // walk the perimeter in place, same order as Tilemap::getRectangle() without corners
   int maxDst2road = getRoadAccessDistance();
-  TilemapTiles rect = tilemap.getRectangle( _getMasterTile()->getIJ() + TilePos( -maxDst2road, -maxDst2road ),
-                                            getSize() + Size( 2 * maxDst2road ), !Tilemap::checkCorners );
-  foreach( Tile* tile, rect )
+  TilePos start = _getMasterTile()->getIJ() - TilePos( maxDst2road, maxDst2road );
+  TilePos stop = start + TilePos( getSize().getWidth() + 2 * maxDst2road - 1,
+                                  getSize().getHeight() + 2 * maxDst2road - 1 );
+
+  for( int i=start.getI() + 1; i <= stop.getI() - 1; i++ )
   {
-    if( tile->getFlag( Tile::tlRoad ) )
-    {
-      _d->accessRoads.push_back( tile );
-    }
+    _d->appendAccessRoad( tilemap, TilePos( i, start.getJ() ) );
+    _d->appendAccessRoad( tilemap, TilePos( i, stop.getJ() ) );
+  }
+
+  for( int j=start.getJ() + 1; j <= stop.getJ() - 1; j++ )
+  {
+    _d->appendAccessRoad( tilemap, TilePos( start.getI(), j ) );
+    _d->appendAccessRoad( tilemap, TilePos( stop.getI(), j ) );
   }
 }
 
@@ -130,13 +181,15 @@ const MetaData::Desirability& Construction::getDesirabilityInfo() const
 
 void Construction::destroy()
 {
+  _d->updateFireRisk( this, CityServiceFireRisk::noBucket );
+  _d->fireRisk = SmartPtr< CityServiceFireRisk >();
+
   TileOverlay::destroy();
 }
 
 void Construction::updateState(Construction::Param param, double value, bool relative)
 {
-  if( relative ) _d->params[ param ] += value;
-  else           _d->params[ param ] = value;
+  _d->setParam( this, param, relative ? _d->params[ param ] + value : value );
 }
 
 void Construction::save( VariantMap& stream) const
@@ -165,8 +218,8 @@ void Construction::save( VariantMap& stream) const
 void Construction::load( const VariantMap& stream )
 {
   TileOverlay::load( stream );
-  _d->params[ fire ] = (float)stream.get( Serializable::damageLevel, 0.f );
-  _d->params[ damage ] = (float)stream.get( Serializable::fireLevel, 0.f );
+  _d->setParam( this, fire, (float)stream.get( Serializable::damageLevel, 0.f ) );
+  _d->setParam( this, damage, (float)stream.get( Serializable::fireLevel, 0.f ) );
 //    Construction::unserialize(stream);
 //    _damageLevel = (float)stream.read_int(1, 0, 100);
 //    _fireLevel = (float)stream.read_int(1, 0, 100);
@@ -199,18 +252,47 @@ TilePos Construction::getEnterPos() const
             : _d->accessRoads.front()->getIJ();
 }
 
-void Construction::timeStep(const unsigned long time)
+void Construction::think()
 {
   if( getState( Construction::damage ) >= 100 )
   {
-    Logger::warning( "Building destroyed!" );
-    collapse();
+    _d->intent = Impl::collapseIntent;
   }
   else if( getState( Construction::fire ) >= 100 )
   {
-    Logger::warning( "Building catch fire!" );
+    _d->intent = Impl::burnIntent;
+  }
+  else
+  {
+    _d->intent = Impl::noIntent;
+  }
+}
+
+void Construction::timeStep(const unsigned long time)
+{
+  const Impl::Intent intent = _d->intent;
+  _d->intent = Impl::noIntent;
+
+  switch( intent )
+  {
+  case Impl::collapseIntent:
+  {
+    static Logger::RateLimit collapseWarning( 1000, Logger::catBuilding );
+    collapseWarning.warning( "Building destroyed!" );
+    collapse();
+  }
+  break;
+
+  case Impl::burnIntent:
+  {
+    static Logger::RateLimit fireWarning( 1000, Logger::catBuilding );
+    fireWarning.warning( "Building catch fire!" );
     burn();
   }
+  break;
+
+  default: break;
+  }
 
   TileOverlay::timeStep( time );
 }
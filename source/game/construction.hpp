@@ -28,7 +28,7 @@
 class Construction : public TileOverlay
 {
 public:
-  typedef enum { fire=0, damage } Param;
+  typedef enum { fire=0, damage, paramCount } Param;
   Construction( const TileOverlay::Type type, const Size& size );
   virtual ~Construction();
 
@@ -47,9 +47,11 @@ public:
   virtual double getState( Param param ) const;
   virtual TilePos getEnterPos() const;
   virtual void timeStep(const unsigned long time);
+  virtual void think();
 
   virtual void save(VariantMap& stream) const;
   virtual void load(const VariantMap& stream);
+
 protected:
   class Impl;
   ScopedPtr< Impl > _d;
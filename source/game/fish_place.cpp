@@ -21,6 +21,7 @@
 #include "pathway.hpp"
 #include "walker/walker.hpp"
 #include "constants.hpp"
+#include "core/random.hpp"
 
 class FishPlace::Impl
 {
@@ -39,9 +40,20 @@ FishPlace::FishPlace() : TileOverlay( constants::place::fishPlace ), _d( new Imp
   _d->animations.resize( 1 );
   _d->passQueue.push_back( Renderer::foreground );
   _d->passQueue.push_back( Renderer::animations );
+  _d->fishCount = 0;
+}
+
+FishPlace::~FishPlace()
+{
+
+}
 
-  _d->fishCount = rand() % 100;
+void FishPlace::build(CityPtr city, const TilePos& pos)
+{
+  // fish count comes from city generator, so replay places same fish
+  _d->fishCount = city->getRandom().get() % 100;
 
+  _getAnimation().clear();
   if( _d->fishCount > 1 )
   {
     _getAnimation().load( ResourceGroup::land3a, 19, 24); //big fish place
@@ -54,15 +66,7 @@ FishPlace::FishPlace() : TileOverlay( constants::place::fishPlace ), _d( new Imp
     _d->basicOffset =  Point( 0, 55 );
     _getAnimation().setOffset( _d->basicOffset );
   } //small fish place
-}
-
-FishPlace::~FishPlace()
-{
 
-}
-
-void FishPlace::build(CityPtr city, const TilePos& pos)
-{
   _d->savePicture = &city->getTilemap().at( pos ).getPicture();
   setPicture( *_d->savePicture );
 
@@ -74,12 +78,15 @@ void FishPlace::initTerrain(Tile& terrain)
 
 }
 
-void FishPlace::timeStep(const unsigned long time)
+void FishPlace::animate( unsigned int time )
 {
   _getAnimation().update( time );
 
   _d->animations[ 0 ] = _getAnimation().getFrame();
+}
 
+void FishPlace::timeStep(const unsigned long time)
+{
   if( _d->walker != 0 )
   {
     TilePos lastPos = _d->walker->getIJ();
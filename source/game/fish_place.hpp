@@ -27,6 +27,7 @@ public:
   virtual void build(CityPtr city, const TilePos &pos);
   virtual void initTerrain(Tile &terrain);
   virtual void timeStep(const unsigned long time);
+  virtual void animate( unsigned int time );
   virtual void destroy();
 
   const PicturesArray& getPictures(Renderer::Pass pass) const;
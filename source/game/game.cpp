@@ -26,6 +26,7 @@
 #include "astarpathfinding.hpp"
 #include "building/metadata.hpp"
 #include "gfx/picture_bank.hpp"
+#include "gfx/loader_sg2.hpp"
 #include "screen_menu.hpp"
 #include "screen_game.hpp"
 #include "house_level.hpp"
@@ -41,11 +42,12 @@
 #include "name_generator.hpp"
 #include "loader.hpp"
 #include "win_targets.hpp"
-#include "gamedate.hpp"
 #include "saver.hpp"
 #include "core/saveadapter.hpp"
 #include "events/dispatcher.hpp"
 #include "core/logger.hpp"
+#include "walker/walker.hpp"
+#include "cityservice_timers.hpp"
 
 #include <libintl.h>
 #include <list>
@@ -105,6 +107,7 @@ void Game::Impl::initVideo()
 
   engine->setScreenSize( GameSettings::get( GameSettings::resolution ).toSize() );
   engine->setFlag( GfxEngine::fullscreen, GameSettings::get( GameSettings::fullscreen ).toBool() ? 1 : 0 );
+  engine->setFlag( GfxEngine::rleSprites, GameSettings::get( GameSettings::rleSprites ).toBool() ? 1 : 0 );
   engine->init();
 }
 
@@ -124,6 +127,13 @@ void Game::mountArchives()
   fs.mountArchive( GameSettings::rcpath( "/pics/pics_wait.zip" ) );
   fs.mountArchive( GameSettings::rcpath( "/pics/pics.zip" ) );
   fs.mountArchive( GameSettings::rcpath( "/pics/pics_oc3.zip" ) );
+
+  // original game graphics are read without extraction when folder is set
+  std::string c3gfx = GameSettings::get( GameSettings::c3gfx ).toString();
+  if( !c3gfx.empty() )
+  {
+    PictureLoaderSg2::instance().mountDirectory( c3gfx );
+  }
 }
 
 void Game::Impl::initGuiEnvironment()
@@ -232,8 +242,6 @@ void Game::setScreenGame()
       {
         _d->empire->timeStep( _d->time );
 
-        GameDate::timeStep( _d->time );
-
         _d->saveTime += 1;
 
         screen.animate( _d->saveTime );
@@ -241,8 +249,13 @@ void Game::setScreenGame()
     }
 
     events::Dispatcher::update( _d->time );
+    Logger::update();
   }
 
+  events::Dispatcher::stopRecording();
+  WalkerHelper::printStatistic();
+  CityServiceTimers::getInstance().printStatistic();
+
   switch( screen.getResult() )
   {
     case ScreenGame::mainMenu:
@@ -267,6 +280,18 @@ bool Game::isPaused() const { return _d->pauseCounter>0; }
 void Game::play() { setPaused( false ); }
 void Game::pause() { setPaused( true ); }
 
+void Game::step( unsigned int count )
+{
+  while( count-- > 0 )
+  {
+    _d->time += 1;
+    _d->empire->timeStep( _d->time );
+
+    _d->saveTime += 1;
+    events::Dispatcher::update( _d->time );
+  }
+}
+
 void Game::setPaused(bool value)
 {
   _d->pauseCounter = math::clamp( _d->pauseCounter + (value ? 1 : -1 ), 0, 99 );
@@ -345,8 +370,26 @@ void Game::load(std::string filename)
     }
   }
 
+  CityHelper helper( _d->city );
+  helper.rebuildDesirability();
+
   Pathfinder::getInstance().update( _d->city->getTilemap() );
 
+  // loaded city starts its own clock, replay times count from here
+  _d->time = 0;
+  _d->saveTime = 0;
+
+  std::string replayPath = GameSettings::get( GameSettings::replayPath ).toString();
+  std::string recordPath = GameSettings::get( GameSettings::recordPath ).toString();
+  if( !replayPath.empty() )
+  {
+    events::Dispatcher::startReplay( replayPath, _d->city->getRandom() );
+  }
+  else if( !recordPath.empty() )
+  {
+    events::Dispatcher::startRecording( recordPath, filename, _d->city->getRandom() );
+  }
+
   Logger::warning( "Load game end" );
   return;
 }
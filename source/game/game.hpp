@@ -61,6 +61,9 @@ public:
   void play();
   void pause();
 
+  // advances simulation by count ticks without drawing, used by oc3_bench
+  void step( unsigned int count=1 );
+
   void changeTimeMultiplier(int percent);
   void setTimeMultiplier( int percent );
   int getTimeMultiplier() const;
@@ -14,12 +14,20 @@
 // along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "gamedate.hpp"
+#include "timer.hpp"
+#include "core/logger.hpp"
 
 class GameDate::Impl
 {
 public:
   DateTime lastDateUpdate;
   DateTime current;
+  TimerPtr monthTimer;
+
+  void appendMonth()
+  {
+    current.appendMonth( 1 );
+  }
 };
 
 
@@ -34,16 +42,6 @@ GameDate& GameDate::instance()
   return inst;
 }
 
-void GameDate::timeStep( unsigned int time )
-{
-  if( time % 110 == 1 )
-  {
-    // every X seconds
-    GameDate& inst = instance();
-    inst._d->current.appendMonth( 1 );
-  }
-}
-
 void GameDate::init( const DateTime& date )
 {
   instance()._d->current = date;
@@ -53,9 +51,13 @@ void GameDate::init( const DateTime& date )
 GameDate::GameDate() : _d( new Impl )
 {
   _d->current = DateTime( -350, 0, 0 );
+
+  // month passes every 110 ticks
+  _d->monthTimer = Timer::createPeriodic( 110, 1 );
+  CONNECT( _d->monthTimer, onTimeout(), _d.data(), Impl::appendMonth );
 }
 
 GameDate::~GameDate()
 {
-
+  _d->monthTimer->destroy();
 }
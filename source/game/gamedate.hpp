@@ -24,8 +24,6 @@ class GameDate
 public:
   static DateTime current();
 
-  static void timeStep( unsigned int time );
-
   static void init( const DateTime& date );
 
   static GameDate& instance();
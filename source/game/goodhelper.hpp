@@ -33,7 +33,7 @@ public:
   static Picture getPicture( Good::Type type, bool emp=false );
   static Good::Type getType( const std::string& name );
   static std::string getTypeName( Good::Type type );
-  static Picture getCartPicture( const GoodStock& stock, constants::Direction direction );
+  static const Picture& getCartPicture( const GoodStock& stock, constants::Direction direction );
   ~GoodHelper();
 private:
   GoodHelper();
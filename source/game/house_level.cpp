@@ -515,15 +515,8 @@ int HouseLevelSpec::computeDesirabilityLevel(HousePtr house, std::string& oMissi
 {
   CityPtr city = house->_getCity();
 
-  TilemapArea area = city->getTilemap().getArea( house->getTilePos() - TilePos( 2, 2 ), house->getSize() + Size( 4 ) );
-
-  float middleDesirbl = (float)area.front()->getDesirability();
-  foreach( Tile* tile, area )
-  {
-    middleDesirbl = (middleDesirbl + (float)tile->getDesirability() )/2.f;
-  }
-
-  return (int)middleDesirbl;
+  CityHelper helper( city );
+  return helper.getDesirability( house->getTilePos() - TilePos( 2, 2 ), house->getSize() + Size( 4 ) );
 }
 
 HouseLevelSpec& HouseLevelSpec::operator=( const HouseLevelSpec& other )
@@ -18,6 +18,7 @@
 #include "tilemap.hpp"
 #include "core/direction.hpp"
 #include "core/logger.hpp"
+#include "core/mempool.hpp"
 
 using namespace  constants;
 
@@ -35,6 +36,8 @@ bool operator<(const Pathway &v1, const Pathway &v2)
 class Pathway::Impl
 {
 public:
+  OC3_POOLED_ALLOCATION
+
   TilePos destination;
   bool isReverse;
 
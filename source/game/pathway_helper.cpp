@@ -17,6 +17,7 @@
 #include "astarpathfinding.hpp"
 #include "city.hpp"
 #include "tilemap.hpp"
+#include "core/random.hpp"
 
 Pathway PathwayHelper::create(CityPtr city, TilePos startPos, TilePos stopPos,
                                WayType type/*=roadOnly */, Size arrivedArea )
@@ -57,7 +58,7 @@ Pathway PathwayHelper::randomWay(CityPtr city, TilePos startPos, int walkRadius)
   {
     const Tilemap& tmap = city->getTilemap();
 
-    TilePos destPos( std::rand() % walkRadius - walkRadius / 2, std::rand() % walkRadius - walkRadius / 2 );
+    TilePos destPos( city->getRandom().get() % walkRadius - walkRadius / 2, city->getRandom().get() % walkRadius - walkRadius / 2 );
     destPos = (startPos+destPos).fit( TilePos( 0, 0 ), TilePos( tmap.getSize()-1, tmap.getSize()-1 ) );
 
     if( tmap.at( destPos ).isWalkable( true) )
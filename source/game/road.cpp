@@ -71,7 +71,7 @@ void Road::build( CityPtr city, const TilePos& pos )
     }
   }*/
 
-  city->updateRoads();
+  city->updateRoads( pos );
 }
 
 bool Road::canBuild( CityPtr city, const TilePos& pos ) const
@@ -52,9 +52,8 @@ ConstTilemapWay RoadPropagator::createPath( const Tilemap& tileMap, const Tile&
   int iStep = (startPos.getI() < stopPos.getI()) ? 1 : -1;
   int jStep = (startPos.getJ() < stopPos.getJ()) ? 1 : -1;
 
-  std::cout << "RoadPropagator::getPath" << std::endl;
-
-  Logger::warning( "(%d, %d) to (%d, %d)", startPos.getI(), startPos.getJ(), stopPos.getI(), stopPos.getJ() );
+  OC3_DEBUG_MSG( Logger::catRoad, "RoadPropagator::createPath (%d, %d) to (%d, %d)",
+                 startPos.getI(), startPos.getJ(), stopPos.getI(), stopPos.getJ() );
 
   if( startPos == stopPos )
   {
@@ -62,28 +61,24 @@ ConstTilemapWay RoadPropagator::createPath( const Tilemap& tileMap, const Tile&
     return ret;
   }
 
-  std::cout << "propagate by I axis" << std::endl;
-
   // propagate on I axis
   for( TilePos tmp( startPos.getI(), stopPos.getJ() ); ; tmp+=TilePos( iStep, 0 ) )
   {
     const Tile& curTile = tileMap.at( tmp );
 
-    Logger::warning( "+ (%d, %d)", curTile.getI(), curTile.getJ() );
+    OC3_DEBUG_MSG( Logger::catRoad, "+ (%d, %d)", curTile.getI(), curTile.getJ() );
     ret.push_back( &curTile );
 
     if (tmp.getI() == stopPos.getI())
       break;
   }
 
-  std::cout << "propagate by J axis" << std::endl;
-
   // propagate on J axis
   for( int j = startPos.getJ();; j+=jStep )
   {
     const Tile& curTile = tileMap.at( startPos.getI(), j );
 
-    std::cout << "+ (" << curTile.getI() << " " << curTile.getJ() << ") ";
+    OC3_DEBUG_MSG( Logger::catRoad, "+ (%d, %d)", curTile.getI(), curTile.getJ() );
     ret.push_back( &curTile );
 
     if( j == stopPos.getJ() )
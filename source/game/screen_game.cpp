@@ -127,14 +127,17 @@ void ScreenGame::initialize()
   _d->extMenu->setPosition( Point( engine.getScreenWidth() - _d->extMenu->getWidth() - _d->rightPanel->getWidth(), 
                                      _d->topMenu->getHeight() ) );
 
-  Minimap* mmap = new Minimap( _d->extMenu, Rect( 8, 35, 8 + 144, 35 + 110 ),
-                               city->getTilemap(),
-                               city->getClimate() );
+  Minimap* mmap = new Minimap( _d->extMenu, Rect( 8, 35, 8 + 144, 35 + 110 ), city );
 
   WindowMessageStack::create( gui.getRootWidget() );
 
   _d->rightPanel->bringToFront();
 
+  // menus are opaque and change rarely, they are blitted from layers
+  _d->topMenu->setCached( true );
+  _d->menu->setCached( true );
+  _d->extMenu->setCached( true );
+
   // 8*30: used for high buildings (granary...), visible even when not in tilemap_area.
   _d->renderer.getCamera().setViewport( engine.getScreenSize() + Size( 180 ) );
 
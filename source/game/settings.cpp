@@ -28,6 +28,10 @@ const char* GameSettings::resolution = "resolution";
 const char* GameSettings::fullscreen = "fullscreen";
 const char* GameSettings::localeName = "en_US";
 const char* GameSettings::emigrantSalaryKoeff = "emigrantSalaryKoeff";
+const char* GameSettings::recordPath = "recordPath";
+const char* GameSettings::replayPath = "replayPath";
+const char* GameSettings::c3gfx = "c3gfx";
+const char* GameSettings::rleSprites = "rleSprites";
 
 class GameSettings::Impl
 {
@@ -55,6 +59,7 @@ GameSettings::GameSettings() : _d( new Impl )
   _d->options[ settingsPath ] = Variant( std::string( "/settings.model" ) );
   _d->options[ resolution ] = Size( 1024, 768 );
   _d->options[ fullscreen ] = false;
+  _d->options[ rleSprites ] = false;
   _d->options[ emigrantSalaryKoeff ] = 2.f;
 }
 
@@ -36,6 +36,10 @@ public:
   static const char* resolution;
   static const char* fullscreen;
   static const char* emigrantSalaryKoeff;
+  static const char* recordPath;
+  static const char* replayPath;
+  static const char* c3gfx;
+  static const char* rleSprites;
 
   static GameSettings& getInstance();
 
@@ -27,23 +27,24 @@
 #include "core/logger.hpp"
 
 static Tile invalidTile = Tile( TilePos( -1, -1 ) );
-typedef std::vector< Tile > Row;
 
-class TileGrid : public std::vector< Row >
-{
-};
-
-class Tilemap::Impl : public TileGrid
+class Tilemap::Impl
 {
 public:
+  typedef std::vector< Tile > Tiles;
+
+  Tiles tiles;  // one block, tile (i, j) is at i * size + j
+  int size;
+
   Tile& at( const int i, const int j )
   {
     if( isInside( TilePos( i, j ) ) )
     {
-      return TileGrid::at(i).at(j);
+      return tiles[ i * size + j ];
     }
 
-    Logger::warning( "Need inside point current=[%d, %d]", i, j );
+    static Logger::RateLimit outsideWarning( 1000, Logger::catTilemap );
+    outsideWarning.warning( "Need inside point current=[%d, %d]", i, j );
     return invalidTile;
   }
 
@@ -57,19 +58,16 @@ public:
     size = s;
 
     // resize the tile array
-    TileGrid::resize( size );
+    tiles.clear();
+    tiles.reserve( size * size );
     for( int i = 0; i < size; ++i )
     {
-      TileGrid::at( i ).reserve( size );
-
       for (int j = 0; j < size; ++j)
       {
-        TileGrid::at( i ).push_back( Tile( TilePos( i, j ) ));
+        tiles.push_back( Tile( TilePos( i, j ) ));
       }
     }
   }
-
-  int size;
 };
 
 Tilemap::Tilemap() : _d( new Impl )
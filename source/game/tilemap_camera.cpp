@@ -34,7 +34,10 @@ public:
   Size viewSize;    // width of the view (in tiles)  nb_tilesX = 1+2*_view_width
                     // height of the view (in tiles)  nb_tilesY = 1+2*_view_height
 
-  TilemapArea tiles;  // cached list of visible tiles
+  TilesArray tiles;  // cached visible tiles
+  bool outdated;     // camera moved since tiles were cached
+
+  void updateTiles();
 
 public oc3_signals:
   Signal1<Point> onPositionChangedSignal;
@@ -46,6 +49,7 @@ TilemapCamera::TilemapCamera() : _d( new Impl )
   _d->viewSize = Size( 0 );
   _d->center = TilePos( 0, 0 );
   _d->centerMapXZ = Point( 0, 0 );
+  _d->outdated = true;
 }
 
 TilemapCamera::~TilemapCamera()
@@ -55,13 +59,14 @@ TilemapCamera::~TilemapCamera()
 void TilemapCamera::init(Tilemap &tilemap)
 {
   _d->tilemap = &tilemap;
+  _d->outdated = true;
 }
 
 void TilemapCamera::setViewport(const Size& newSize )
 {
   if( _d->viewSize != newSize )
   {
-    _d->tiles.clear();
+    _d->outdated = true;
   }
 
   _d->viewSize = Size( (newSize.getWidth() + 59) / 60, ( newSize.getHeight() + 29) / 30 );
@@ -82,7 +87,7 @@ void TilemapCamera::setCenter( const Point& pos )
 {
   if( _d->centerMapXZ != pos  )
   {
-    _d->tiles.clear();
+    _d->outdated = true;
   }
   
   _d->centerMapXZ = pos;
@@ -118,56 +123,51 @@ void TilemapCamera::moveDown(const int amount)
   setCenter( Point( getCenterX(), getCenterZ() - amount ) );
 }
 
-const TilemapArea& TilemapCamera::getTiles() const
+const TilesArray& TilemapCamera::getTiles() const
 {
-  if( _d->tiles.empty() )
+  if( _d->outdated )
   {
-    int mapSize = _d->tilemap->getSize();
-    int zm = _d->tilemap->getSize() + 1;
-    int cx = _d->centerMapXZ.getX();
-    int cz = _d->centerMapXZ.getY();
+    _d->updateTiles();
+  }
 
-    Size sizeT = _d->viewSize;  // size x
+  return _d->tiles;
+}
 
-    for (int z = cz + sizeT.getHeight(); z>=cz - sizeT.getHeight(); --z)
-    {
-      // depth axis. from far to near.
+void TilemapCamera::Impl::updateTiles()
+{
+  // vectors keep their capacity, so scrolling does not allocate
+  tiles.clear();
+  outdated = false;
 
-      int xstart = cx - sizeT.getWidth();
-      if ((xstart + z) % 2 == 0)
-      {
-	      ++xstart;
-      }
+  if( tilemap == NULL )
+    return;
 
-      for (int x = xstart; x<=cx + sizeT.getWidth(); x+=2)
-      {
-	// left-right axis
-        int j = (x + z - zm)/2;
-        int i = x - j;
-
-        if( (i >= 0) && (j >= 0) && (i < mapSize) && (j < mapSize) )
-        {
-          _d->tiles.push_back( &_d->tilemap->at( i, j ));
-        }
-      }
-    }
+  int mapSize = tilemap->getSize();
+  int zm = mapSize + 1;
+  int cx = centerMapXZ.getX();
+  int cz = centerMapXZ.getY();
+
+  Size sizeT = viewSize;  // size x
 
-    /*for( int y=0; y < mapSize; y++ )
+  for (int z = cz + sizeT.getHeight(); z>=cz - sizeT.getHeight(); --z)
+  {
+    // depth axis. from far to near.
+    int xstart = cx - sizeT.getWidth();
+    if ((xstart + z) % 2 == 0)
     {
-      for( int t=0; t <= y; t++ )
-      {
-        _d->tiles.push_back( &_d->tilemap->at( t, mapSize - 1 - ( y - t ) ) );
-      }
+      ++xstart;
     }
 
-    for( int x=1; x < mapSize; x++ )
+    for (int x = xstart; x<=cx + sizeT.getWidth(); x+=2)
     {
-      for( int t=0; t < mapSize-x; t++ )
+      // left-right axis
+      int j = (x + z - zm)/2;
+      int i = x - j;
+
+      if( (i >= 0) && (j >= 0) && (i < mapSize) && (j < mapSize) )
       {
-        _d->tiles.push_back( &_d->tilemap->at( x + t, t ) );
+        tiles.push_back( &tilemap->at( i, j ) );
       }
-    }*/
+    }
   }
-
-  return _d->tiles;
 }
@@ -44,8 +44,9 @@ public:
   void moveUp(const int amount);
   void moveDown(const int amount);
 
-  // return tile coordinates (i, j), in order of depth
-  const TilemapArea& getTiles() const;
+  // return tile coordinates (i, j), in order of depth; tiles are cached
+  // until camera moves, then refilled without new allocations
+  const TilesArray& getTiles() const;
 
   int getCenterX() const;
   int getCenterZ() const;
@@ -15,6 +15,7 @@
 
 #include "timer.hpp"
 #include "game/cityservice_timers.hpp"
+#include <algorithm>
 
 class Timer::Impl
 {
@@ -24,6 +25,16 @@ public:
   int id;
   bool loop;
   bool isActive;
+  bool isStarted;
+  bool isPeriodic;
+  unsigned int phase;
+  unsigned int due;
+
+  // first tick not earlier than time, which gives phase as remainder
+  unsigned int nextTick( unsigned int time ) const
+  {
+    return time + ( phase + this->time - time % this->time ) % this->time;
+  }
 
 oc3_signals public:
   Signal1<int> onTimeoutASignal;
@@ -40,6 +51,10 @@ Timer::Timer() : _d( new Impl )
   _d->isActive = true;
   _d->loop = false;
   _d->startTime = 0;
+  _d->isStarted = false;
+  _d->isPeriodic = false;
+  _d->phase = 0;
+  _d->due = 0;
 }
 
 TimerPtr Timer::create( unsigned int time, bool loop, int id/*=-1 */ )
@@ -55,11 +70,46 @@ TimerPtr Timer::create( unsigned int time, bool loop, int id/*=-1 */ )
   return ret;
 }
 
+TimerPtr Timer::createPeriodic( unsigned int period, unsigned int phase )
+{
+  TimerPtr ret( new Timer() );
+  ret->_d->time = std::max<unsigned int>( period, 1 );
+  ret->_d->phase = phase % ret->_d->time;
+  ret->_d->loop = true;
+  ret->_d->isPeriodic = true;
+  ret->_d->id = -1;
+  ret->drop();
+
+  CityServiceTimers::getInstance().addTimer( ret );
+
+  return ret;
+}
+
 void Timer::update( unsigned int time )
 {
-  if( !_d->startTime )
+  if( _d->isPeriodic )
+  {
+    if( !_d->isStarted )
+    {
+      _d->due = _d->nextTick( time );
+      _d->isStarted = true;
+    }
+
+    // game time can step over the due tick, then timer fires late once
+    if( _d->isActive && time >= _d->due )
+    {
+      _d->onTimeoutASignal.emit( _d->id );
+      _d->onTimeoutSignal.emit();
+      _d->due = _d->nextTick( time + 1 );
+    }
+
+    return;
+  }
+
+  if( !_d->isStarted )
   {
     _d->startTime = time;
+    _d->isStarted = true;
   }
 
   if( _d->isActive && ( time - _d->startTime > _d->time) )
@@ -80,6 +130,12 @@ void Timer::update( unsigned int time )
 void Timer::setTime( unsigned int time )
 {
   _d->time = time;
+
+  if( _d->isStarted && _d->isActive )
+  {
+    // due time changed, timer must be moved to other slot
+    CityServiceTimers::getInstance().addTimer( this );
+  }
 }
 
 void Timer::setLoop( bool loop )
@@ -87,6 +143,11 @@ void Timer::setLoop( bool loop )
   _d->loop = loop;
 }
 
+void Timer::restart()
+{
+  _d->isStarted = false;
+}
+
 Signal1<int>& Timer::onTimeoutA()
 {
   return _d->onTimeoutASignal;
@@ -102,6 +163,11 @@ bool Timer::isActive() const
   return _d->isActive;
 }
 
+unsigned int Timer::getDueTime() const
+{
+  return _d->isPeriodic ? _d->due : _d->startTime + _d->time + 1;
+}
+
 void Timer::destroy()
 {
   _d->isActive = false; 
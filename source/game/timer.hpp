@@ -30,6 +30,10 @@ public:
   enum { looped=true, singleShot=false };
   static TimerPtr create( unsigned int time, bool loop, int id=-1 );
 
+  // fires on every tick which gives phase as remainder of period,
+  // owners pick different phases to spread their work over the period
+  static TimerPtr createPeriodic( unsigned int period, unsigned int phase );
+
   ~Timer();
 
   void update( unsigned int time );
@@ -37,7 +41,13 @@ public:
   void setTime( unsigned int time );
   void setLoop( bool loop );
 
+  // timer counts again from next update, used when game time was reset
+  void restart();
+
   bool isActive() const;
+
+  // game time when timer will fire, valid after first update
+  unsigned int getDueTime() const;
   
   void destroy();
 
@@ -14,14 +14,41 @@
 // along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "animation.hpp"
+#include "animation_bank.hpp"
 #include "core/position.hpp"
-#include "core/foreach.hpp"
+#include "core/math.hpp"
 #include "core/stringhelper.hpp"
 
-class Animation::Impl
+namespace
 {
-public:
-};
+  static const PicturesArray emptyFrames;
+}
+
+AnimationClip::AnimationClip()
+{
+}
+
+AnimationClipPtr AnimationClip::create( const std::string& key, const PicturesArray& frames )
+{
+  AnimationClip* clip = new AnimationClip();
+  AnimationClipPtr ret( clip );
+  ret->drop();
+
+  clip->_key = key;
+  clip->_frames = frames;
+
+  return ret;
+}
+
+const PicturesArray& AnimationClip::getFrames() const
+{
+  return _frames;
+}
+
+const std::string& AnimationClip::getKey() const
+{
+  return _key;
+}
 
 void Animation::start(bool loop)
 {
@@ -30,22 +57,34 @@ void Animation::start(bool loop)
   _loop = loop;
 }
 
-PicturesArray& Animation::getFrames()
+const PicturesArray& Animation::getFrames() const
 {
-  return _pictures;
+  return _clip.isValid() ? _clip->getFrames() : emptyFrames;
 }
 
-const PicturesArray& Animation::getFrames() const
+std::string Animation::_getKey() const
 {
-  return _pictures;
+  return _clip.isValid() ? _clip->getKey() : "";
 }
 
 void Animation::setOffset( const Point& offset )
 {
-  foreach( Picture& pic, _pictures )
+  std::string key = _getKey() + StringHelper::format( 0xff, "@%d,%d;", offset.getX(), offset.getY() );
+  AnimationClipPtr clip = AnimationBank::getClip( key );
+
+  if( clip.isNull() )
   {
-    pic.setOffset( offset );
+    PicturesArray frames = getFrames();
+    for( PicturesArray::iterator it=frames.begin(); it != frames.end(); it++ )
+    {
+      it->setOffset( offset );
+    }
+
+    clip = AnimationClip::create( key, frames );
+    AnimationBank::addClip( clip );
   }
+
+  _clip = clip;
 }
 
 void Animation::update( unsigned int time )
@@ -62,7 +101,7 @@ void Animation::update( unsigned int time )
   _animIndex += 1;
   _lastTimeUpdate = time;
 
-  if( _animIndex >= (int)_pictures.size() ) 
+  if( _animIndex >= size() ) 
   {
     _animIndex = _loop ? 0 : -1;
   }
@@ -70,8 +109,8 @@ void Animation::update( unsigned int time )
 
 const Picture& Animation::getFrame() const
 {
-  return ( _animIndex >= 0 && _animIndex < (int)_pictures.size())
-                  ? _pictures[_animIndex] 
+  return ( _animIndex >= 0 && _animIndex < size() )
+                  ? _clip->getFrames()[_animIndex] 
                   : Picture::getInvalid();
 }
 
@@ -82,10 +121,10 @@ int Animation::getIndex() const
 
 void Animation::setIndex(int index)
 {
-  _animIndex = math::clamp<int>( index, 0, _pictures.size()-1 );
+  _animIndex = math::clamp<int>( index, 0, size()-1 );
 }
 
-Animation::Animation() : _d( new Impl )
+Animation::Animation()
 {
   _frameDelay = 0;
   start( true );
@@ -96,7 +135,7 @@ Animation::~Animation()
 
 }
 
-Animation::Animation(const Animation& other) : _d( new Impl )
+Animation::Animation(const Animation& other)
 {
   *this = other;
 }
@@ -114,17 +153,30 @@ void Animation::setLoop( bool loop )
 void Animation::load( const std::string &prefix, const int start, const int number, 
                       bool reverse /*= false*/, const int step /*= 1*/ )
 {  
-  int revMul = reverse ? -1 : 1;
-  for( int i = 0; i < number; ++i)
+  // every building of a type loads the same frames, so they are kept once
+  std::string key = _getKey() + StringHelper::format( 0xff, "%s:%d:%d:%d:%d;", prefix.c_str(),
+                                                      start, number, reverse ? 1 : 0, step );
+  AnimationClipPtr clip = AnimationBank::getClip( key );
+
+  if( clip.isNull() )
   {
-    const Picture& pic = Picture::load(prefix, start + revMul*i*step);
-    _pictures.push_back( pic );
+    PicturesArray frames = getFrames();
+    int revMul = reverse ? -1 : 1;
+    for( int i = 0; i < number; ++i)
+    {
+      frames.push_back( Picture::load(prefix, start + revMul*i*step) );
+    }
+
+    clip = AnimationClip::create( key, frames );
+    AnimationBank::addClip( clip );
   }
+
+  _clip = clip;
 }
 
 void Animation::clear()
 {
-  _pictures.clear();
+  _clip = AnimationClipPtr();
 }
 
 bool Animation::isRunning() const
@@ -144,10 +196,10 @@ void Animation::stop()
 
 Animation& Animation::operator=( const Animation& other )
 {
-  _pictures = other._pictures;
+  _clip = other._clip;
   _animIndex = other._animIndex;  // index of the current frame
   _frameDelay = other._frameDelay;
-  _lastTimeUpdate = _lastTimeUpdate;
+  _lastTimeUpdate = other._lastTimeUpdate;
   _loop = other._loop;
 
   return *this;
@@ -155,10 +207,10 @@ Animation& Animation::operator=( const Animation& other )
 
 int Animation::size() const
 {
-  return _pictures.size();
+  return _clip.isValid() ? _clip->getFrames().size() : 0;
 }
 
 bool Animation::isValid() const
 {
-  return _pictures.size() > 0;
+  return size() > 0;
 }
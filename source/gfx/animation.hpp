@@ -17,8 +17,30 @@
 #define __OPENCAESAR3_ANIMATION_H_INCLUDE_
 
 #include "picture.hpp"
+#include "core/smartptr.hpp"
 
-// several frames for a basic visual animation
+// frames of animation, immutable once created and shared between all
+// animations that were loaded the same way, see AnimationBank::getClip()
+class AnimationClip : public ReferenceCounted
+{
+public:
+  static SmartPtr< AnimationClip > create( const std::string& key, const PicturesArray& frames );
+
+  const PicturesArray& getFrames() const;
+
+  // describes how frames were loaded, same key means same frames
+  const std::string& getKey() const;
+
+private:
+  AnimationClip();
+
+  PicturesArray _frames;
+  std::string _key;
+};
+
+typedef SmartPtr< AnimationClip > AnimationClipPtr;
+
+// several frames for a basic visual animation: shared clip and frame cursor
 class Animation
 {
 public:
@@ -35,7 +57,6 @@ public:
   void start(bool loop=true);
   void stop();
 
-  PicturesArray& getFrames();
   const PicturesArray& getFrames() const;
 
   int getIndex() const;
@@ -61,15 +82,14 @@ public:
 
   bool isValid() const;
 private:
-  PicturesArray _pictures;
+  std::string _getKey() const;
+
+  AnimationClipPtr _clip;
   int _animIndex;  // index of the current frame
   unsigned int _frameDelay;
   unsigned int _lastTimeUpdate;
 
   bool _loop;
-
-  class Impl;
-  ScopedPtr<Impl> _d;
 };
 
 #endif
@@ -20,6 +20,7 @@
 #include "game/resourcegroup.hpp"
 #include "gfx/picture.hpp"
 #include "core/logger.hpp"
+#include "core/stringhelper.hpp"
 #include "walker/emigrant.hpp"
 #include <vector>
 
@@ -50,11 +51,14 @@ namespace{
 class AnimationBank::Impl
 {
 public:
-  std::map< int, PicturesArray > carts;
+  std::vector< PicturesArray > carts;  // index=cart id, resolved once on load
   
   typedef std::vector< AnimationBank::MovementAnimation > Animations;
   Animations animations; // anim[WalkerGraphic][WalkerAction]
 
+  typedef std::map< unsigned int, std::vector< AnimationClipPtr > > Clips;
+  Clips clips;  // key=hash of clip key
+
   // fills the cart pictures
   // prefix: image prefix
   // start: index of the first frame
@@ -72,6 +76,7 @@ void AnimationBank::Impl::loadCarts()
   //number of animations with goods + emmigrants + immigrants
   bool frontCart = false;
 
+  carts.resize( Emigrant::CT_MAX );
   carts[Good::none] = fillCart(ResourceGroup::carts, noneGoodsPicId, frontCart);
   carts[Good::wheat] = fillCart(ResourceGroup::carts, 9, frontCart);
   carts[Good::vegetable] = fillCart(ResourceGroup::carts, 17, frontCart);
@@ -184,6 +189,29 @@ const AnimationBank::MovementAnimation& AnimationBank::getWalker( gfx::Type anim
   return inst._d->animations[ anim ];
 }
 
+AnimationClipPtr AnimationBank::getClip( const std::string& key )
+{
+  Impl::Clips& clips = instance()._d->clips;
+  Impl::Clips::iterator it = clips.find( StringHelper::hash( key ) );
+  if( it != clips.end() )
+  {
+    for( std::vector< AnimationClipPtr >::iterator k=it->second.begin(); k != it->second.end(); k++ )
+    {
+      if( (*k)->getKey() == key )
+      {
+        return *k;
+      }
+    }
+  }
+
+  return AnimationClipPtr();
+}
+
+void AnimationBank::addClip( AnimationClipPtr clip )
+{
+  instance()._d->clips[ StringHelper::hash( clip->getKey() ) ].push_back( clip );
+}
+
 void AnimationBank::loadWalkers()
 {
   Logger::warning( "Start loading walkers graphics" );
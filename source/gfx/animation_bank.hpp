@@ -41,6 +41,10 @@ public:
 
   static const MovementAnimation& getWalker( const constants::gfx::Type walkerGraphic );
 
+  // clips loaded by animations, so every object of a type refers to the same frames
+  static AnimationClipPtr getClip( const std::string& key );
+  static void addClip( AnimationClipPtr clip );
+
 private:
   AnimationBank();
 
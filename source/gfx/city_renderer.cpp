@@ -83,6 +83,16 @@ public:
   Layer::VisibleWalkers visibleWalkers;
   LayerPtr currentLayer;
 
+  TilesArray animatedTiles;  // tiles with own animation, like water
+
+  // buildings rise above their master tile, so screen is taken with margin
+  bool isVisible( const Tile& tile ) const
+  {
+    const int margin = 200;
+    Point pos = tile.getXY() + mapOffset;
+    return pos.getX() > -margin && pos.getX() < engine->getScreenWidth() + margin
+           && pos.getY() > -margin && pos.getY() < engine->getScreenHeight() + margin;
+  }
 
   void getSelectedArea( TilePos& outStartPos, TilePos& outStopPos );
   // returns the tile at the cursor position.
@@ -102,12 +112,14 @@ public:
   Tile* getTile( const Point& pos, bool overborder);
 
   WalkerList getVisibleWalkerList();
-  void drawWalkersBetweenZ( WalkerList walkerList, int minZ, int maxZ );
+  void drawWalkersBetweenZ( const WalkerList& walkerList, int minZ, int maxZ );
 
-  void resetWasDrawn( TilemapArea tiles )
+  void resetWasDrawn( const TilesArray& tiles )
   {
-    foreach( Tile* tile, tiles )
-      tile->resetWasDrawn();
+    for( TilesArray::const_iterator it=tiles.begin(); it != tiles.end(); it++ )
+    {
+      (*it)->resetWasDrawn();
+    }
   }
 
 oc3_signals public:
@@ -129,6 +141,22 @@ void CityRenderer::initialize( CityPtr city, GfxEngine* engine )
   _d->tilemap = &city->getTilemap();
   _d->camera.init( *_d->tilemap );
   _d->engine = engine;
+
+  // water keeps its animation for whole game, so tiles are collected once
+  _d->animatedTiles.clear();
+  int size = _d->tilemap->getSize();
+  for( int i=0; i < size; i++ )
+  {
+    for( int j=0; j < size; j++ )
+    {
+      Tile& tile = _d->tilemap->at( i, j );
+      if( tile.getAnimation().isValid() )
+      {
+        _d->animatedTiles.push_back( &tile );
+      }
+    }
+  }
+
   _d->clearPic = Picture::load( "oc3_land", 2 );
 
   addLayer( LayerSimple::create( this, city ) );
@@ -221,7 +249,7 @@ void CityRenderer::Impl::renderTilesRTools()
 
   int lastZ = -1000;  // dummy value
 
-  TilemapArea visibleTiles = camera.getTiles();
+  const TilesArray& visibleTiles = camera.getTiles();
   resetWasDrawn( visibleTiles );
 
   TilePos startPos, stopPos;
@@ -248,8 +276,9 @@ void CityRenderer::Impl::renderTilesRTools()
   //Rect destroyArea = Rect( startPos.getI(), startPos.getJ(), stopPos.getI(), stopPos.getJ() );
 
   // FIRST PART: draw all flat land (walkable/boatable)
-  foreach( Tile* tile, visibleTiles )
+  for( TilesArray::const_iterator it=visibleTiles.begin(); it != visibleTiles.end(); it++ )
   {
+    Tile* tile = *it;
     Tile* master = tile->getMasterTile();
 
     if( !tile->isFlat() )
@@ -277,8 +306,9 @@ void CityRenderer::Impl::renderTilesRTools()
 
   // SECOND PART: draw all sprites, impassable land and buildings
   WalkerList walkerList = getVisibleWalkerList();
-  foreach( Tile* tile, visibleTiles )
+  for( TilesArray::const_iterator it=visibleTiles.begin(); it != visibleTiles.end(); it++ )
   {
+    Tile* tile = *it;
     int z = tile->getIJ().getZ();
 
     if (z != lastZ)
@@ -307,16 +337,17 @@ void CityRenderer::Impl::renderTiles()
 
   int lastZ = -1000;  // dummy value
 
-  TilemapArea visibleTiles = camera.getTiles();
+  const TilesArray& visibleTiles = camera.getTiles();
 
-  foreach( Tile* tile, visibleTiles )
+  for( TilesArray::const_iterator it=visibleTiles.begin(); it != visibleTiles.end(); it++ )
   {
-    tile->resetWasDrawn();
+    (*it)->resetWasDrawn();
   }
 
   // FIRST PART: draw all flat land (walkable/boatable)
-  foreach( Tile* tile, visibleTiles )
+  for( TilesArray::const_iterator it=visibleTiles.begin(); it != visibleTiles.end(); it++ )
   {
+    Tile* tile = *it;
     Tile* master = tile->getMasterTile();
 
     if( !tile->isFlat() )
@@ -338,8 +369,9 @@ void CityRenderer::Impl::renderTiles()
   // SECOND PART: draw all sprites, impassable land and buildings
   WalkerList walkerList = getVisibleWalkerList();
 
-  foreach( Tile* tile, visibleTiles )
+  for( TilesArray::const_iterator it=visibleTiles.begin(); it != visibleTiles.end(); it++ )
   {
+    Tile* tile = *it;
     int z = tile->getIJ().getZ();
 
     if (z != lastZ)
@@ -587,12 +619,13 @@ void CityRenderer::Impl::buildAll()
   }
 }
 
-void CityRenderer::Impl::drawWalkersBetweenZ(WalkerList walkerList, int minZ, int maxZ)
+void CityRenderer::Impl::drawWalkersBetweenZ( const WalkerList& walkerList, int minZ, int maxZ )
 {
   PicturesArray pictureList;
 
-  foreach( WalkerPtr walker, walkerList )
+  for( WalkerList::const_iterator it=walkerList.begin(); it != walkerList.end(); it++ )
   {
+    WalkerPtr walker = *it;
     // TODO: calculate once && sort
     int zAnim = walker->getIJ().getZ();// getJ() - walker.getI();
     if( zAnim > minZ && zAnim <= maxZ )
@@ -830,11 +863,22 @@ void CityRenderer::setMode( const TilemapChangeCommandPtr command )
 
 void CityRenderer::animate(unsigned int time)
 {
-  TilemapArea visibleTiles = _d->camera.getTiles();
+  // only registered animations are advanced, and only when they are on screen
+  for( TilesArray::iterator it=_d->animatedTiles.begin(); it != _d->animatedTiles.end(); it++ )
+  {
+    if( _d->isVisible( **it ) )
+    {
+      (*it)->animate( time );
+    }
+  }
 
-  foreach( Tile* tile, visibleTiles )
+  TileOverlayList& overlays = _d->city->getAnimatedOverlays();
+  for( TileOverlayList::iterator it=overlays.begin(); it != overlays.end(); it++ )
   {
-    tile->animate( time );
+    if( !(*it)->isDeleted() && _d->isVisible( (*it)->getTile() ) )
+    {
+      (*it)->animate( time );
+    }
   }
 }
 
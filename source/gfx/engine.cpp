@@ -85,3 +85,12 @@ int GfxEngine::getFlag(int flag) const
   std::map< int, int >::const_iterator it = _flags.find( flag );
   return it != _flags.end() ? it->second : 0;
 }
+
+bool GfxEngine::setRenderTarget( Picture* target, const Point& offset, const Rect& clip )
+{
+  return false;
+}
+
+void GfxEngine::resetRenderTarget()
+{
+}
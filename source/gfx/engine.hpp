@@ -32,7 +32,7 @@ public:
   typedef Size Mode;
   typedef std::vector<Size> Modes;
 
-  typedef enum { fullscreen=0, debugInfo } Flags;
+  typedef enum { fullscreen=0, debugInfo, rleSprites } Flags;
   static GfxEngine& instance();
 
   GfxEngine();
@@ -63,6 +63,11 @@ public:
   virtual void drawPicture(const Picture &pic, const int dx, const int dy, Rect* clipRect=0 ) = 0;
   virtual void drawPicture(const Picture &pic, const Point& pos, Rect* clipRect=0 ) = 0;
 
+  // pictures are drawn into target instead of screen until reset, positions are
+  // shifted by -offset and clipped by clip rect; false when engine can't do it
+  virtual bool setRenderTarget( Picture* target, const Point& offset, const Rect& clip );
+  virtual void resetRenderTarget();
+
   virtual void setTileDrawMask( int rmask, int gmask, int bmask, int amask ) = 0;
   virtual void resetTileDrawMask() = 0;
   
@@ -17,6 +17,7 @@
 #include "tileoverlay.hpp"
 #include "core/foreach.hpp"
 #include "game/resourcegroup.hpp"
+#include "picture_bank.hpp"
 
 void Layer::drawTilePass( GfxEngine& engine, Tile& tile, Point offset, Renderer::Pass pass)
 {
@@ -36,6 +37,8 @@ void Layer::drawArea( GfxEngine& engine, const TilemapArea& area, Point offset,
   Tile* baseTile = area.front();
   TileOverlayPtr overlay = baseTile->getOverlay();
   Picture *pic = NULL;
+  PictureBank& bank = PictureBank::instance();
+  const unsigned int groupId = bank.getGroupId( resourceGroup );
   int leftBorderAtI = baseTile->getI();
   int rightBorderAtJ = overlay->getSize().getHeight() - 1 + baseTile->getJ();
   for( TilemapArea::const_iterator it=area.begin(); it != area.end(); it++ )
@@ -43,17 +46,20 @@ void Layer::drawArea( GfxEngine& engine, const TilemapArea& area, Point offset,
     Tile* tile = *it;
     int tileBorders = ( tile->getI() == leftBorderAtI ? 0 : OverlayPic::skipLeftBorder )
                       + ( tile->getJ() == rightBorderAtJ ? 0 : OverlayPic::skipRightBorder );
-    pic = &Picture::load(resourceGroup, tileBorders + tileId);
+    pic = &bank.getPicture( groupId, tileBorders + tileId );
     engine.drawPicture( *pic, tile->getXY() + offset );
   }
 }
 
 void Layer::drawColumn( GfxEngine& engine, const Point& pos, const int startPicId, const int percent)
 {
-  engine.drawPicture( Picture::load( ResourceGroup::sprites, startPicId + 2 ), pos + Point( 5, 15 ) );
+  PictureBank& bank = PictureBank::instance();
+  static const unsigned int spritesGroupId = bank.getGroupId( ResourceGroup::sprites );
+
+  engine.drawPicture( bank.getPicture( spritesGroupId, startPicId + 2 ), pos + Point( 5, 15 ) );
 
   int roundPercent = ( percent / 10 ) * 10;
-  Picture& pic = Picture::load( ResourceGroup::sprites, startPicId + 1 );
+  Picture& pic = bank.getPicture( spritesGroupId, startPicId + 1 );
   for( int offsetY=10; offsetY < roundPercent; offsetY += 10 )
   {
     engine.drawPicture( pic, pos - Point( -13, -5 + offsetY ) );
@@ -61,6 +67,6 @@ void Layer::drawColumn( GfxEngine& engine, const Point& pos, const int startPicI
 
   if( percent >= 10 )
   {
-    engine.drawPicture( Picture::load( ResourceGroup::sprites, startPicId ), pos - Point( -1, -6 + roundPercent ) );
+    engine.drawPicture( bank.getPicture( spritesGroupId, startPicId ), pos - Point( -1, -6 + roundPercent ) );
   }
 }
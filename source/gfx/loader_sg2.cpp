@@ -0,0 +1,627 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "loader_sg2.hpp"
+#include "engine.hpp"
+#include "core/logger.hpp"
+#include "core/stringhelper.hpp"
+#include "core/bytearray.hpp"
+#include "vfs/filemapping.hpp"
+#include "vfs/filelist.hpp"
+
+#include <SDL.h>
+#include <map>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+namespace
+{
+  enum
+  {
+    sgHeaderSize = 680,
+    sgBitmapRecordSize = 200,
+    sgImageRecordSize = 64,
+    sgAlphaRecordSize = 8
+  };
+
+  enum
+  {
+    isoTileWidth = 58,
+    isoTileHeight = 30,
+    isoTileBytes = 1800,
+    isoLargeTileWidth = 78,
+    isoLargeTileHeight = 40,
+    isoLargeTileBytes = 3200
+  };
+
+  inline unsigned int readUint32( const char* data )
+  {
+    const unsigned char* p = (const unsigned char*)data;
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24);
+  }
+
+  inline unsigned short readUint16( const char* data )
+  {
+    const unsigned char* p = (const unsigned char*)data;
+    return p[0] | (p[1] << 8);
+  }
+
+  //! writes 555 colors to locked 32bit surface in its own format
+  class Canvas
+  {
+  public:
+    Canvas( SDL_Surface* surface ) : _surface( surface ), _format( surface->format ) {}
+
+    int getWidth() const { return _surface->w; }
+    int getHeight() const { return _surface->h; }
+
+    void set555Pixel( int x, int y, unsigned short color )
+    {
+      // magenta is the transparent color of 555 files
+      if( color == 0xf81f || !_isInside( x, y ) )
+        return;
+
+      unsigned int r = ((color & 0x7c00) >> 7) | ((color & 0x7000) >> 12);
+      unsigned int g = ((color & 0x3e0) >> 2) | ((color & 0x300) >> 8);
+      unsigned int b = ((color & 0x1f) << 3) | ((color & 0x1c) >> 2);
+
+      _pixel( x, y ) = ((r >> _format->Rloss) << _format->Rshift)
+                       | ((g >> _format->Gloss) << _format->Gshift)
+                       | ((b >> _format->Bloss) << _format->Bshift)
+                       | _format->Amask;
+    }
+
+    void setAlphaPixel( int x, int y, unsigned char color )
+    {
+      if( !_isInside( x, y ) )
+        return;
+
+      // only the first five bits of the alpha channel are used
+      unsigned int alpha = ((color & 0x1f) << 3) | ((color & 0x1c) >> 2);
+      Uint32& pixel = _pixel( x, y );
+      pixel = (pixel & ~_format->Amask) | (((alpha >> _format->Aloss) << _format->Ashift) & _format->Amask);
+    }
+
+    void mirror()
+    {
+      for( int y=0; y < _surface->h; y++ )
+      {
+        Uint32* row = &_pixel( 0, y );
+        for( int left=0, right=_surface->w - 1; left < right; left++, right-- )
+        {
+          std::swap( row[ left ], row[ right ] );
+        }
+      }
+    }
+
+  private:
+    bool _isInside( int x, int y ) const
+    {
+      return x >= 0 && y >= 0 && x < _surface->w && y < _surface->h;
+    }
+
+    Uint32& _pixel( int x, int y )
+    {
+      return ((Uint32*)( (Uint8*)_surface->pixels + y * _surface->pitch ))[ x ];
+    }
+
+    SDL_Surface* _surface;
+    SDL_PixelFormat* _format;
+  };
+}
+
+class PictureLoaderSg2::Impl
+{
+public:
+  struct Record
+  {
+    unsigned int offset;
+    unsigned int length;
+    unsigned int uncompressedLength;
+    int invertOffset;
+    short width;
+    short height;
+    unsigned short type;
+    char flags[4];
+    unsigned char bitmapId;
+    unsigned int alphaOffset;
+    unsigned int alphaLength;
+  };
+
+  struct Bitmap
+  {
+    io::FilePath sg2file;
+    std::string filename;  // from bitmap record, names external 555 file
+    io::FileMappingPtr pixels[2];  // internal and external 555 files
+    bool searched[2];
+  };
+
+  struct Image
+  {
+    unsigned int bitmap;
+    unsigned int record;
+    bool invert;
+  };
+
+  typedef std::map< unsigned int, Image > Images;
+
+  std::vector< Record > records;
+  std::vector< Bitmap > bitmaps;
+  Images images;  // key=hash of lowercase name
+
+  static unsigned int getNameKey( const std::string& name );
+  io::FileMappingPtr getPixels( Bitmap& bitmap, bool external );
+  io::FilePath find555( const io::FilePath& directory, const std::string& filename );
+
+  void loadPlainImage( Canvas& canvas, const Record& r, const unsigned char* buffer );
+  void loadIsometricImage( Canvas& canvas, const Record& r, const unsigned char* buffer );
+  void loadAlphaMask( Canvas& canvas, const Record& r, const unsigned char* buffer );
+  void writeIsometricTile( Canvas& canvas, const unsigned char* buffer,
+                           int offsetX, int offsetY, int tileWidth, int tileHeight );
+  void writeTransparentImage( Canvas& canvas, const unsigned char* buffer, int length );
+};
+
+PictureLoaderSg2& PictureLoaderSg2::instance()
+{
+  static PictureLoaderSg2 inst;
+  return inst;
+}
+
+PictureLoaderSg2::PictureLoaderSg2() : _d( new Impl )
+{
+}
+
+PictureLoaderSg2::~PictureLoaderSg2()
+{
+}
+
+unsigned int PictureLoaderSg2::Impl::getNameKey( const std::string& name )
+{
+  io::FilePath basename = io::FilePath( name ).getBasename( false );
+  return StringHelper::hash( StringHelper::localeLower( basename.toString() ) );
+}
+
+bool PictureLoaderSg2::mount( const io::FilePath& sg2file )
+{
+  io::FileMappingPtr sg = io::FileMapping::open( sg2file );
+  if( sg.isNull() || sg->getSize() < sgHeaderSize )
+  {
+    Logger::warning( "SG2: can't open %s", sg2file.toString().c_str() );
+    return false;
+  }
+
+  const char* data = sg->getData();
+  const unsigned int filesize = readUint32( data );
+  const unsigned int version = readUint32( data + 4 );
+  const int numImages = (int)readUint32( data + 16 );
+  const int numBitmaps = (int)readUint32( data + 20 );
+
+  bool validVersion = (version == 0xd3 && (filesize == 74480 || filesize == 522680))
+                      || ((version == 0xd5 || version == 0xd6) && (filesize == 74480 || filesize == sg->getSize()));
+  if( !validVersion || numImages < 0 || numBitmaps <= 0 )
+  {
+    Logger::warning( "SG2: unsupported file %s", sg2file.toString().c_str() );
+    return false;
+  }
+
+  const int maxBitmaps = (version == 0xd3) ? 100 : 200;
+  const bool includeAlpha = version >= 0xd6;
+  const unsigned int recordSize = sgImageRecordSize + (includeAlpha ? sgAlphaRecordSize : 0);
+  const unsigned int imagesStart = sgHeaderSize + maxBitmaps * sgBitmapRecordSize;
+
+  if( numBitmaps > maxBitmaps || imagesStart + (numImages + 1) * recordSize > sg->getSize() )
+  {
+    Logger::warning( "SG2: broken index in %s", sg2file.toString().c_str() );
+    return false;
+  }
+
+  const unsigned int bitmapBase = _d->bitmaps.size();
+  std::vector< std::string > bitmapNames;
+  for( int i=0; i < numBitmaps; i++ )
+  {
+    const char* record = data + sgHeaderSize + i * sgBitmapRecordSize;
+
+    Impl::Bitmap bitmap;
+    bitmap.sg2file = sg2file;
+    bitmap.filename = std::string( record, std::find( record, record + 64, '\0' ) );
+    bitmap.searched[0] = bitmap.searched[1] = false;
+    _d->bitmaps.push_back( bitmap );
+
+    std::string name = StringHelper::localeLower( bitmap.filename );
+    std::string::size_type ext = name.rfind( ".bmp" );
+    bitmapNames.push_back( ext != std::string::npos ? name.erase( ext, 4 ) : name );
+  }
+
+  // first record is a dummy
+  const unsigned int recordBase = _d->records.size();
+  for( int i=0; i < numImages; i++ )
+  {
+    const char* record = data + imagesStart + (i + 1) * recordSize;
+
+    Impl::Record r;
+    r.offset = readUint32( record );
+    r.length = readUint32( record + 4 );
+    r.uncompressedLength = readUint32( record + 8 );
+    r.invertOffset = (int)readUint32( record + 16 );
+    r.width = (short)readUint16( record + 20 );
+    r.height = (short)readUint16( record + 22 );
+    r.type = readUint16( record + 50 );
+    memcpy( r.flags, record + 52, 4 );
+    r.bitmapId = (unsigned char)record[ 56 ];
+    r.alphaOffset = includeAlpha ? readUint32( record + 64 ) : 0;
+    r.alphaLength = includeAlpha ? readUint32( record + 68 ) : 0;
+
+    _d->records.push_back( r );
+  }
+
+  // inverted images take data and bitmap from the image they mirror,
+  // numbers go by order of images inside every bitmap
+  std::vector< Impl::Image > images( numImages );
+  std::vector< int > positions( numImages, 0 );
+  std::vector< int > counts( numBitmaps, 0 );
+  for( int i=0; i < numImages; i++ )
+  {
+    const Impl::Record& own = _d->records[ recordBase + i ];
+    int work = i;
+    if( own.invertOffset < 0 && i + own.invertOffset >= 0 )
+    {
+      work = i + own.invertOffset;
+    }
+
+    images[ i ].bitmap = _d->records[ recordBase + work ].bitmapId;
+    images[ i ].record = recordBase + work;
+    images[ i ].invert = own.invertOffset != 0;
+
+    if( images[ i ].bitmap < (unsigned int)numBitmaps )
+    {
+      positions[ i ] = ++counts[ images[ i ].bitmap ];
+    }
+  }
+
+  // file with only first bitmap in use names its images by file name
+  bool single = (numBitmaps == 1 || counts[ 0 ] == numImages);
+  std::string basename = StringHelper::localeLower( sg2file.getBasename( false ).toString() );
+
+  unsigned int added = 0;
+  for( int i=0; i < numImages; i++ )
+  {
+    Impl::Image& image = images[ i ];
+    if( positions[ i ] == 0 || (single && image.bitmap != 0) )
+      continue;
+
+    std::string name = StringHelper::format( 0xff, "%s_%05d",
+                                             (single ? basename : bitmapNames[ image.bitmap ]).c_str(),
+                                             positions[ i ] );
+    image.bitmap += bitmapBase;
+
+    // first mounted file wins, like archives in file system
+    unsigned int key = Impl::getNameKey( name );
+    if( _d->images.find( key ) == _d->images.end() )
+    {
+      _d->images[ key ] = image;
+      added++;
+    }
+  }
+
+  Logger::warning( "SG2: mounted %s with %d images", sg2file.toString().c_str(), added );
+  return true;
+}
+
+void PictureLoaderSg2::mountDirectory( const io::FilePath& directory )
+{
+  io::FileList::Items items = io::FileDir( directory ).getEntries().filter( io::FileList::file, "" ).getItems();
+  for( io::FileList::ItemIt it=items.begin(); it != items.end(); it++ )
+  {
+    if( it->fullName.isExtension( ".sg2", false ) )
+    {
+      mount( it->fullName );
+    }
+  }
+}
+
+bool PictureLoaderSg2::isALoadableName( const std::string& name ) const
+{
+  return _d->images.find( Impl::getNameKey( name ) ) != _d->images.end();
+}
+
+io::FilePath PictureLoaderSg2::Impl::find555( const io::FilePath& directory, const std::string& filename )
+{
+  io::FilePath path = io::FileDir( directory ).getFilePath( filename );
+  if( path.isExist() )
+  {
+    return path;
+  }
+
+  // original files come from windows, names may differ in case
+  io::FileList::Items items = io::FileDir( directory ).getEntries().filter( io::FileList::file, "" ).getItems();
+  for( io::FileList::ItemIt it=items.begin(); it != items.end(); it++ )
+  {
+    if( StringHelper::isEquale( it->fullName.getBasename().toString(), filename, StringHelper::equaleIgnoreCase ) )
+    {
+      return it->fullName;
+    }
+  }
+
+  return io::FilePath();
+}
+
+io::FileMappingPtr PictureLoaderSg2::Impl::getPixels( Bitmap& bitmap, bool external )
+{
+  const int index = external ? 1 : 0;
+  if( !bitmap.searched[ index ] )
+  {
+    bitmap.searched[ index ] = true;
+
+    std::string filename = external
+                             ? bitmap.filename
+                             : bitmap.sg2file.getBasename().toString();
+
+    std::string::size_type dot = filename.rfind( '.' );
+    if( dot != std::string::npos )
+    {
+      filename.replace( dot + 1, 3, "555" );
+    }
+
+    io::FilePath directory = bitmap.sg2file.getFileDir();
+    io::FilePath path = find555( directory, filename );
+    if( path.toString().empty() )
+    {
+      path = find555( io::FileDir( directory ).getFilePath( "555" ), filename );
+    }
+
+    bitmap.pixels[ index ] = path.toString().empty()
+                               ? io::FileMappingPtr()
+                               : io::FileMapping::open( path );
+
+    if( bitmap.pixels[ index ].isNull() )
+    {
+      Logger::warning( "SG2: can't find pixels file %s", filename.c_str() );
+    }
+  }
+
+  return bitmap.pixels[ index ];
+}
+
+Picture PictureLoaderSg2::load( const std::string& name )
+{
+  Impl::Images::iterator it = _d->images.find( Impl::getNameKey( name ) );
+  if( it == _d->images.end() )
+  {
+    return Picture::getInvalid();
+  }
+
+  const Impl::Image& image = it->second;
+  const Impl::Record& r = _d->records[ image.record ];
+  if( r.width <= 0 || r.height <= 0 || r.length == 0 )
+  {
+    Logger::warning( "SG2: no image data for %s", name.c_str() );
+    return Picture::getInvalid();
+  }
+
+  const bool external = r.flags[0] != 0;
+  io::FileMappingPtr pixels = _d->getPixels( _d->bitmaps[ image.bitmap ], external );
+  if( pixels.isNull() )
+  {
+    return Picture::getInvalid();
+  }
+
+  // external images have 1 byte added to their offset
+  const unsigned int offset = r.offset - (external ? 1 : 0);
+  const unsigned int dataLength = r.length + r.alphaLength;
+  const unsigned char* buffer = (const unsigned char*)pixels->getData() + offset;
+
+  // some images at the end of file miss their last 4 bytes
+  ByteArray padded;
+  if( offset + dataLength > pixels->getSize() )
+  {
+    if( offset + dataLength - 4 != pixels->getSize() )
+    {
+      Logger::warning( "SG2: image data out of file for %s", name.c_str() );
+      return Picture::getInvalid();
+    }
+
+    padded.resize( dataLength, 0 );
+    memcpy( padded.data(), buffer, dataLength - 4 );
+    buffer = (const unsigned char*)padded.data();
+  }
+
+  Picture* pic = GfxEngine::instance().createPicture( Size( r.width, r.height ) );
+  GfxEngine::instance().loadPicture( *pic );
+
+  SDL_Surface* surface = pic->getSurface();
+  SDL_FillRect( surface, NULL, 0 );  // transparent black
+  SDL_LockSurface( surface );
+
+  Canvas canvas( surface );
+  switch( r.type )
+  {
+    case 0: case 1: case 10: case 12: case 13:
+      _d->loadPlainImage( canvas, r, buffer );
+    break;
+
+    case 30:
+      _d->loadIsometricImage( canvas, r, buffer );
+    break;
+
+    case 256: case 257: case 276:
+      _d->writeTransparentImage( canvas, buffer, r.length );
+    break;
+
+    default:
+      Logger::warning( "SG2: unknown image type %d for %s", r.type, name.c_str() );
+    break;
+  }
+
+  if( r.alphaLength > 0 )
+  {
+    _d->loadAlphaMask( canvas, r, buffer + r.length );
+  }
+
+  if( image.invert )
+  {
+    canvas.mirror();
+  }
+
+  SDL_UnlockSurface( surface );
+
+  return *pic;
+}
+
+void PictureLoaderSg2::Impl::loadPlainImage( Canvas& canvas, const Record& r, const unsigned char* buffer )
+{
+  if( r.width * r.height * 2 != (int)r.length )
+  {
+    Logger::warning( "SG2: image data length doesn't match image size" );
+    return;
+  }
+
+  int i = 0;
+  for( int y=0; y < r.height; y++ )
+  {
+    for( int x=0; x < r.width; x++, i+=2 )
+    {
+      canvas.set555Pixel( x, y, buffer[i] | (buffer[i+1] << 8) );
+    }
+  }
+}
+
+void PictureLoaderSg2::Impl::loadIsometricImage( Canvas& canvas, const Record& r, const unsigned char* buffer )
+{
+  const int width = canvas.getWidth();
+  const int height = (width + 2) / 2;  // 58 -> 30, 118 -> 60, etc
+  int size = r.flags[3];
+
+  if( size == 0 )
+  {
+    // derive tile size from the height, 4x4 regular tiles take precedence over 3x3 large
+    if( height % isoTileHeight == 0 ) { size = height / isoTileHeight; }
+    else if( height % isoLargeTileHeight == 0 ) { size = height / isoLargeTileHeight; }
+  }
+
+  int tileBytes, tileHeight, tileWidth;
+  if( size > 0 && isoTileHeight * size == height )
+  {
+    tileBytes = isoTileBytes;
+    tileHeight = isoTileHeight;
+    tileWidth = isoTileWidth;
+  }
+  else if( size > 0 && isoLargeTileHeight * size == height )
+  {
+    tileBytes = isoLargeTileBytes;
+    tileHeight = isoLargeTileHeight;
+    tileWidth = isoLargeTileWidth;
+  }
+  else
+  {
+    Logger::warning( "SG2: unknown tile size, height %d width %d size %d", height, width, size );
+    return;
+  }
+
+  if( (width + 2) * height != (int)r.uncompressedLength || r.uncompressedLength > r.length )
+  {
+    Logger::warning( "SG2: data length doesn't match footprint size" );
+    return;
+  }
+
+  int i = 0;
+  int offsetY = canvas.getHeight() - height;
+  for( int y=0; y < size + (size - 1); y++ )
+  {
+    int offsetX = (y < size ? (size - y - 1) : (y - size + 1)) * tileHeight;
+    for( int x=0; x < (y < size ? y + 1 : 2 * size - y - 1); x++, i++ )
+    {
+      writeIsometricTile( canvas, buffer + i * tileBytes, offsetX, offsetY, tileWidth, tileHeight );
+      offsetX += tileWidth + 2;
+    }
+    offsetY += tileHeight / 2;
+  }
+
+  writeTransparentImage( canvas, buffer + r.uncompressedLength, r.length - r.uncompressedLength );
+}
+
+void PictureLoaderSg2::Impl::writeIsometricTile( Canvas& canvas, const unsigned char* buffer,
+                                                 int offsetX, int offsetY, int tileWidth, int tileHeight )
+{
+  const int halfHeight = tileHeight / 2;
+  int i = 0;
+
+  for( int y=0; y < tileHeight; y++ )
+  {
+    int start = y < halfHeight ? tileHeight - 2 * (y + 1) : 2 * y - tileHeight;
+    int end = tileWidth - start;
+    for( int x=start; x < end; x++, i+=2 )
+    {
+      canvas.set555Pixel( offsetX + x, offsetY + y, buffer[i] | (buffer[i+1] << 8) );
+    }
+  }
+}
+
+void PictureLoaderSg2::Impl::writeTransparentImage( Canvas& canvas, const unsigned char* buffer, int length )
+{
+  const int width = canvas.getWidth();
+  int i = 0, x = 0, y = 0;
+
+  while( i < length )
+  {
+    unsigned char c = buffer[i++];
+    if( c == 255 )
+    {
+      // next byte is the number of pixels to skip
+      if( i >= length )
+        break;
+
+      x += buffer[i++];
+      while( x >= width ) { y++; x -= width; }
+    }
+    else
+    {
+      // c is the number of pixels that follow
+      for( int j=0; j < c && i + 1 < length; j++, i+=2 )
+      {
+        canvas.set555Pixel( x, y, buffer[i] | (buffer[i+1] << 8) );
+        if( ++x >= width ) { y++; x = 0; }
+      }
+    }
+  }
+}
+
+void PictureLoaderSg2::Impl::loadAlphaMask( Canvas& canvas, const Record& r, const unsigned char* buffer )
+{
+  const int width = canvas.getWidth();
+  const int length = r.alphaLength;
+  int i = 0, x = 0, y = 0;
+
+  while( i < length )
+  {
+    unsigned char c = buffer[i++];
+    if( c == 255 )
+    {
+      if( i >= length )
+        break;
+
+      x += buffer[i++];
+      while( x >= width ) { y++; x -= width; }
+    }
+    else
+    {
+      for( int j=0; j < c && i < length; j++, i++ )
+      {
+        canvas.setAlphaPixel( x, y, buffer[i] );
+        if( ++x >= width ) { y++; x = 0; }
+      }
+    }
+  }
+}
@@ -0,0 +1,52 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __OPENCAESAR3_PICTURELOADER_SG2_H_INCLUDED__
+#define __OPENCAESAR3_PICTURELOADER_SG2_H_INCLUDED__
+
+#include "picture.hpp"
+#include "core/scopedptr.hpp"
+#include "vfs/filepath.hpp"
+
+//! Reads pictures straight from original .sg2 index and .555 pixel files.
+/** Index and pixel files are memory mapped, every image is decoded on first
+request. Images are named like sgreader extracts them: "land1a_00062". */
+class PictureLoaderSg2
+{
+public:
+  static PictureLoaderSg2& instance();
+
+  //! reads index of sg2 file, pixel files are searched next to it
+  //! or in "555" subdirectory when images are requested
+  bool mount( const io::FilePath& sg2file );
+
+  //! mounts every sg2 file of directory
+  void mountDirectory( const io::FilePath& directory );
+
+  //! name may have extension, "land1a_00062.png" is same as "land1a_00062"
+  bool isALoadableName( const std::string& name ) const;
+
+  //! decodes image into a display format picture
+  Picture load( const std::string& name );
+
+  ~PictureLoaderSg2();
+private:
+  PictureLoaderSg2();
+
+  class Impl;
+  ScopedPtr< Impl > _d;
+};
+
+#endif //__OPENCAESAR3_PICTURELOADER_SG2_H_INCLUDED__
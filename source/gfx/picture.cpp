@@ -22,6 +22,7 @@
 #include "core/rectangle.hpp"
 #include "gfx/picture_bank.hpp"
 #include "gfx/engine.hpp"
+#include "gfx/rlesprite.hpp"
 #include "core/requirements.hpp"
 #include "core/color.hpp"
 #include <SDL.h>
@@ -30,7 +31,7 @@
 
 static const Picture _invalidPicture = Picture();
 
-class Picture::Impl
+class Picture::Impl : public ReferenceCounted
 {
 public:
   // the image is shifted when displayed
@@ -44,26 +45,61 @@ public:
   // for SDL surface
   SDL_Surface* surface;
 
+  // compressed pixels, surface is null while picture is compressed
+  RleSpritePtr rle;
+
   // for OPEN_GL surface
   unsigned int glTextureID;  // texture ID for openGL
+
+  Impl() : offset( 0, 0 ), size( 0 ), surface( 0 ), glTextureID( 0 ) {}
+
+  Impl* clone() const
+  {
+    Impl* ret = new Impl();
+    ret->offset = offset;
+    ret->size = size;
+    ret->name = name;
+    ret->surface = surface;
+    ret->rle = rle;
+    ret->glTextureID = glTextureID;
+
+    return ret;
+  }
 };
 
-Picture::Picture() : _d( new Impl )
+Picture::Picture()
 {
-  _d->surface = NULL;
-  _d->offset = Point( 0, 0 );
-  _d->glTextureID = 0;
-  _d->size = Size( 0 );
-  _d->name = "";
+  // default constructed pictures share one empty body, it is detached on first change
+  static SmartPtr< Impl > empty;
+  if( empty.isNull() )
+  {
+    Impl* impl = new Impl();
+    empty = impl;
+    impl->drop();
+  }
+
+  _d = empty;
 }
 
-Picture::Picture( const Picture& other ) : _d( new Impl )
+Picture::Picture( const Picture& other ) : ReferenceCounted()
 {
-  *this = other;
+  _d = other._d;
+}
+
+void Picture::_detach()
+{
+  // copies share surface and offset until one of them changes
+  if( _d->getReferenceCount() > 1 )
+  {
+    Impl* impl = _d->clone();
+    _d = impl;
+    impl->drop();
+  }
 }
 
 void Picture::init(SDL_Surface *surface, const Point& offset )
 {
+  _detach();
   _d->surface = surface;
   _d->offset = offset;
   _d->size = Size( _d->surface->w, _d->surface->h );
@@ -71,24 +107,80 @@ void Picture::init(SDL_Surface *surface, const Point& offset )
 
 void Picture::setOffset(const int xoffset, const int yoffset)
 {
+  _detach();
   _d->offset = Point( xoffset, yoffset );
 }
 
 void Picture::setOffset( const Point& offset )
 {
+  _detach();
   _d->offset = offset;
 }
 
 void Picture::addOffset(const int dx, const int dy)
 {
+  _detach();
   _d->offset += Point( dx, dy );
 }
 
 SDL_Surface* Picture::getSurface() const
 {
+  if( _d->surface == 0 && _d->rle.isValid() )
+  {
+    return _d->rle->getSurface();
+  }
+
   return _d->surface;
 }
 
+bool Picture::compress()
+{
+  if( _d->surface == 0 || _d->rle.isValid() )
+  {
+    return false;
+  }
+
+  RleSpritePtr rle = RleSprite::create( _d->surface );
+  unsigned int surfaceSize = _d->surface->pitch * _d->surface->h;
+
+  // mostly opaque pictures are cheaper to keep as surfaces
+  if( rle.isNull() || rle->getMemorySize() > surfaceSize * 3 / 4 )
+  {
+    return false;
+  }
+
+  SDL_FreeSurface( _d->surface );
+  _d->surface = 0;
+  _d->rle = rle;
+
+  return true;
+}
+
+bool Picture::isCompressed() const
+{
+  return _d->rle.isValid();
+}
+
+unsigned int Picture::getMemorySize() const
+{
+  if( _d->rle.isValid() )
+  {
+    return _d->rle->getMemorySize();
+  }
+
+  return _d->surface ? _d->surface->pitch * _d->surface->h : 0;
+}
+
+void Picture::_decompress()
+{
+  if( _d->rle.isValid() )
+  {
+    // picture will be changed, so spans can't be used anymore
+    _d->surface = _d->rle->takeSurface();
+    _d->rle = RleSpritePtr();
+  }
+}
+
 Point Picture::getOffset() const
 {
   return _d->offset;
@@ -105,6 +197,7 @@ int Picture::getHeight() const
 
 void Picture::setName(std::string &name)
 {
+  _detach();
   _d->name = name;
 }
 
@@ -120,7 +213,7 @@ Size Picture::getSize() const
 
 bool Picture::isValid() const
 {
-  return _d->surface != 0;
+  return _d->surface != 0 || _d->rle.isValid();
 }
 
 Picture& Picture::load( const std::string& group, const int id )
@@ -135,16 +228,17 @@ Picture& Picture::load( const std::string& filename )
 
 Picture* Picture::createCopy() const
 {
-  if( !_d->surface )
+  SDL_Surface* surface = getSurface();
+  if( !surface )
   {
     _OC3_DEBUG_BREAK_IF( "No surface for duplicate" );
     return GfxEngine::instance().createPicture( Size( 100 ) );
   }
 
-  int width = _d->surface->w;
-  int height = _d->surface->h;
+  int width = surface->w;
+  int height = surface->h;
 
-  SDL_Surface* img = SDL_ConvertSurface( _d->surface, _d->surface->format, SDL_SWSURFACE);
+  SDL_Surface* img = SDL_ConvertSurface( surface, surface->format, SDL_SWSURFACE);
   if (img == NULL) 
   {
     THROW("Cannot make surface, size=" << width << "x" << height);
@@ -163,6 +257,15 @@ void Picture::draw( const Picture &srcpic, const Rect& srcrect, const Point& pos
 
 void Picture::draw( const Picture &srcpic, const Rect& srcrect, const Rect& dstrect, bool useAlpha )
 {
+  _decompress();
+
+  // compressed sprites skip transparent pixels without touching them
+  if( useAlpha && _d->surface && srcpic._d->rle.isValid()
+      && srcpic._d->rle->draw( _d->surface, srcrect, dstrect.getLeft(), dstrect.getTop() ) )
+  {
+    return;
+  }
+
   SDL_Surface *srcimg = srcpic.getSurface();
 
   if( !(srcimg && _d->surface) )
@@ -209,6 +312,8 @@ void Picture::draw( const Picture &srcpic, int x, int y, bool useAlpha/*=true */
 
 void Picture::lock()
 {
+  _decompress();
+
   if (SDL_MUSTLOCK(_d->surface))
   {
     int rc = SDL_LockSurface(_d->surface);
@@ -226,6 +331,8 @@ void Picture::unlock()
 
 int Picture::getPixel(Point pos )
 {
+  _decompress();
+
   // validate arguments
   if( _d->surface == NULL || pos.getX() < 0 || pos.getY() < 0 
       || pos.getX() >= _d->surface->w || pos.getY() >= _d->surface->h)
@@ -266,6 +373,8 @@ int Picture::getPixel(Point pos )
 
 void Picture::setPixel(Point pos, const int color)
 {
+  _decompress();
+
   // validate arguments
   if (_d->surface == NULL || pos.getX() < 0 || pos.getY() < 0 || pos.getX() >= _d->surface->w || pos.getY() >= _d->surface->h)
     return;
@@ -302,17 +411,7 @@ void Picture::setPixel(Point pos, const int color)
 
 Picture& Picture::operator=( const Picture& other )
 {
-  _d->size = other._d->size;
-  // for game save
-  _d->name = other._d->name;
-
-  // for SDL surface
-  _d->surface = other._d->surface;
-
-  // for OPEN_GL surface
-  _d->glTextureID = other._d->glTextureID;  // texture ID for openGL
-
-  _d->offset = other._d->offset;
+  _d = other._d;
 
   return *this;
 }
@@ -334,6 +433,7 @@ void Picture::destroy( Picture* ptr )
 
 void Picture::fill( const NColor& color, const Rect& rect )
 {
+  _decompress();
   SDL_Surface* source = _d->surface;
 
   SDL_LockSurface( source );
@@ -344,6 +444,15 @@ void Picture::fill( const NColor& color, const Rect& rect )
   SDL_UnlockSurface(source);
 }
 
+void Picture::setOpaque( bool opaque )
+{
+  _decompress();
+  if( _d->surface )
+  {
+    SDL_SetAlpha( _d->surface, opaque ? 0 : SDL_SRCALPHA, 0 );
+  }
+}
+
 Picture* Picture::create( const Size& size )
 {
   Picture* ret = GfxEngine::instance().createPicture( size );
@@ -23,6 +23,7 @@
 #include <string>
 #include "core/size.hpp"
 #include "core/scopedptr.hpp"
+#include "core/smartptr.hpp"
 #include "core/referencecounted.hpp"
 #include "core/position.hpp"
 
@@ -30,7 +31,8 @@ class Rect;
 class NColor;
 struct SDL_Surface;
   
-// an image with offset, this is the basic rendered object
+// an image with offset, this is the basic rendered object; copies are cheap,
+// they share one body until offset, name or surface of a copy is changed
 class Picture : public ReferenceCounted
 {
 public:
@@ -60,6 +62,9 @@ public:
 
   void fill( const NColor& color, const Rect& rect );
 
+  // opaque picture is copied when drawn, alpha of its pixels is not blended
+  void setOpaque( bool opaque );
+
   // lock/unlock the given surface for pixel access
   void lock();
   void unlock();
@@ -72,6 +77,14 @@ public:
 
   bool isValid() const;
 
+  // keeps only non transparent spans of picture, returns false when picture
+  // stays a surface; getSurface() decodes compressed picture on request
+  bool compress();
+  bool isCompressed() const;
+
+  // bytes taken by pixels of surface or compressed spans
+  unsigned int getMemorySize() const;
+
   static Picture& load( const std::string& group, const int id );
   static Picture& load( const std::string& filename ); 
 
@@ -81,8 +94,11 @@ public:
 
   unsigned int& getGlTextureID() const;
 private:
+  void _decompress();
+  void _detach();
+
   class Impl;
-  ScopedPtr< Impl > _d;
+  SmartPtr< Impl > _d;
 };
 
 typedef std::vector<Picture> PicturesArray;
@@ -22,6 +22,7 @@
 #include <memory>
 #include <sys/stat.h>
 #include <map>
+#include <vector>
 #include <SDL.h>
 
 #include "core/position.hpp"
@@ -34,6 +35,7 @@
 #include "picture_info_bank.hpp"
 #include "engine.hpp"
 #include "loader.hpp"
+#include "loader_sg2.hpp"
 #include "vfs/file.hpp"
 
 class PictureBank::Impl
@@ -42,9 +44,34 @@ public:
   typedef std::map< unsigned int, Picture> Pictures;
   typedef Pictures::iterator ItPicture;
 
+  typedef std::vector< Picture* > GroupPictures;
+  typedef std::map< unsigned int, unsigned int > GroupIds;
+
+  struct Group
+  {
+    std::string prefix;
+    GroupPictures pictures;  // index=picture idx, value=cached node from resources
+  };
+
   Pictures resources;  // key=image name, value=picture
+  GroupIds groupIds;   // key=prefix hash, value=index in groups
+  std::vector< Group > groups;
+  Picture invalid;
+
+  Picture& compress( Picture& pic );
 };
 
+Picture& PictureBank::Impl::compress( Picture& pic )
+{
+  // only loaded pictures own their surfaces, so only they may be compressed
+  if( GfxEngine::instance().getFlag( GfxEngine::rleSprites ) )
+  {
+    pic.compress();
+  }
+
+  return pic;
+}
+
 PictureBank& PictureBank::instance()
 {
   static PictureBank inst; 
@@ -56,7 +83,8 @@ void PictureBank::setPicture(const std::string &name, SDL_Surface &surface)
   // first: we deallocate the current picture, if any
   unsigned int picId = StringHelper::hash( name );
   Impl::ItPicture it = _d->resources.find( picId );
-  if( it != _d->resources.end() )
+  // surface of compressed picture belongs to its sprite
+  if( it != _d->resources.end() && !it->second.isCompressed() )
   {
      SDL_FreeSurface( it->second.getSurface());
   }
@@ -75,7 +103,19 @@ Picture& PictureBank::getPicture(const std::string &name)
   Impl::ItPicture it = _d->resources.find( hash );
   if( it == _d->resources.end() )
   {
-    //can't find image in valid resources, try load from hdd
+    //can't find image in valid resources, try original sg2 files first
+    PictureLoaderSg2& sg2 = PictureLoaderSg2::instance();
+    if( sg2.isALoadableName( name ) )
+    {
+      Picture tmpPicture = sg2.load( name );
+      if( tmpPicture.isValid() )
+      {
+        setPicture( name, tmpPicture );
+        return _d->compress( _d->resources[ hash ] );
+      }
+    }
+
+    //then load from hdd
     io::NFile file = io::NFile::open( name );
 
     if( file.isOpen() )
@@ -83,7 +123,7 @@ Picture& PictureBank::getPicture(const std::string &name)
       Picture tmpPicture = PictureLoader::instance().load( file );
       setPicture( name, tmpPicture );
 
-      return _d->resources[ hash ];
+      return _d->compress( _d->resources[ hash ] );
     }
     else
     {
@@ -98,9 +138,51 @@ Picture& PictureBank::getPicture(const std::string &name)
 
 Picture& PictureBank::getPicture(const std::string &prefix, const int idx)
 {
-   std::string resource_name = StringHelper::format( 0xff, "%s_%05d.png", prefix.c_str(),idx );
+  return getPicture( getGroupId( prefix ), idx );
+}
+
+Picture& PictureBank::getPicture(const unsigned int groupId, const int idx)
+{
+  if( groupId >= _d->groups.size() || idx < 0 )
+  {
+    Logger::warning( "Unknown resource group %d for index %d", groupId, idx );
+    return _d->invalid;
+  }
+
+  Impl::Group& group = _d->groups[ groupId ];
+  if( (unsigned int)idx >= group.pictures.size() )
+  {
+    group.pictures.resize( idx+1, 0 );
+  }
+
+  Picture*& cached = group.pictures[ idx ];
+  if( cached == 0 )
+  {
+    // map nodes are never removed, so the pointer stays valid after setPicture()
+    std::string resource_name = StringHelper::format( 0xff, "%s_%05d.png", group.prefix.c_str(), idx );
+    cached = &getPicture( resource_name );
+  }
+
+  return *cached;
+}
+
+unsigned int PictureBank::getGroupId( const std::string& prefix )
+{
+  const unsigned int hash = StringHelper::hash( prefix );
+  Impl::GroupIds::iterator it = _d->groupIds.find( hash );
+  if( it != _d->groupIds.end() )
+  {
+    return it->second;
+  }
 
-   return getPicture(resource_name);
+  Impl::Group group;
+  group.prefix = prefix;
+  _d->groups.push_back( group );
+
+  unsigned int groupId = _d->groups.size() - 1;
+  _d->groupIds[ hash ] = groupId;
+
+  return groupId;
 }
 
 Picture PictureBank::makePicture(SDL_Surface *surface, const std::string& resource_name) const
@@ -152,6 +234,17 @@ void PictureBank::createResources()
   setPicture( std::string( ResourceGroup::waterbuildings) + "_00004.png", *fullFontain->getSurface() );
 }
 
+unsigned int PictureBank::getMemorySize() const
+{
+  unsigned int ret = 0;
+  for( Impl::ItPicture it=_d->resources.begin(); it != _d->resources.end(); it++ )
+  {
+    ret += it->second.getMemorySize();
+  }
+
+  return ret;
+}
+
 PictureBank::PictureBank() : _d( new Impl )
 {
 
@@ -161,3 +254,27 @@ PictureBank::~PictureBank()
 {
 
 }
+
+PictureHandle::PictureHandle() : _picture( 0 )
+{
+}
+
+PictureHandle::PictureHandle( const std::string& group, const int idx )
+{
+  _picture = &PictureBank::instance().getPicture( group, idx );
+}
+
+PictureHandle::PictureHandle( const unsigned int groupId, const int idx )
+{
+  _picture = &PictureBank::instance().getPicture( groupId, idx );
+}
+
+const Picture& PictureHandle::get() const
+{
+  return _picture ? *_picture : Picture::getInvalid();
+}
+
+bool PictureHandle::isValid() const
+{
+  return _picture != 0 && _picture->isValid();
+}
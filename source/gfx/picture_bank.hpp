@@ -44,9 +44,18 @@ public:
   // show resource
   Picture& getPicture(const std::string &prefix, const int idx);
 
+  // show resource by numeric group id, see getGroupId()
+  Picture& getPicture(const unsigned int groupId, const int idx);
+
+  // register resource group, return its numeric id
+  unsigned int getGroupId( const std::string& prefix );
+
   // create runtime resources
   void createResources();
 
+  // bytes taken by pixels of all loaded pictures
+  unsigned int getMemorySize() const;
+
   // loads all resources of the given archive file
   //void loadArchive(const std::string &filename, GfxEngine& engine );
   ~PictureBank();
@@ -60,4 +69,21 @@ private:
   ScopedPtr< Impl > _d;
 };
 
+// group/index pair resolved to picture once, can be stored and drawn without lookups
+class PictureHandle
+{
+public:
+  PictureHandle();
+  PictureHandle( const std::string& group, const int idx );
+  PictureHandle( const unsigned int groupId, const int idx );
+
+  const Picture& get() const;
+  operator const Picture&() const { return get(); }
+
+  bool isValid() const;
+
+private:
+  Picture* _picture;
+};
+
 #endif //__OPENCAESAR3_PICLOADER_H_INCLUDED__
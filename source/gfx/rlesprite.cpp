@@ -0,0 +1,253 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "rlesprite.hpp"
+#include "core/rectangle.hpp"
+#include "core/math.hpp"
+
+#include <SDL.h>
+#include <cstring>
+
+namespace
+{
+  const unsigned int alphaMask = 0xff000000;
+
+  // same blend as SDL alpha blit, destination alpha is left untouched
+  inline Uint32 blend( Uint32 src, Uint32 dst )
+  {
+    Uint32 alpha = src >> 24;
+    Uint32 srb = src & 0xff00ff;
+    Uint32 drb = dst & 0xff00ff;
+    Uint32 sg = src & 0xff00;
+    Uint32 dg = dst & 0xff00;
+
+    drb = (drb + (((srb - drb) * alpha) >> 8)) & 0xff00ff;
+    dg = (dg + (((sg - dg) * alpha) >> 8)) & 0xff00;
+
+    return drb | dg | (dst & alphaMask);
+  }
+}
+
+RleSprite::RleSprite() : _surface( 0 )
+{
+}
+
+RleSprite::~RleSprite()
+{
+  // surface taken by picture is not here, see takeSurface()
+  if( _surface )
+  {
+    SDL_FreeSurface( _surface );
+  }
+}
+
+RleSpritePtr RleSprite::create( SDL_Surface* surface )
+{
+  if( surface == 0 || surface->format->BytesPerPixel != 4 || surface->format->Amask != alphaMask )
+  {
+    return RleSpritePtr();
+  }
+
+  RleSprite* rle = new RleSprite();
+  RleSpritePtr ret( rle );
+  ret->drop();
+
+  RleSprite& sprite = *rle;
+  sprite._size = Size( surface->w, surface->h );
+  sprite._rmask = surface->format->Rmask;
+  sprite._gmask = surface->format->Gmask;
+  sprite._bmask = surface->format->Bmask;
+  sprite._amask = surface->format->Amask;
+  sprite._rows.reserve( surface->h + 1 );
+
+  SDL_LockSurface( surface );
+  for( int y=0; y < surface->h; y++ )
+  {
+    const Uint32* row = (const Uint32*)( (Uint8*)surface->pixels + y * surface->pitch );
+    sprite._rows.push_back( sprite._spans.size() );
+
+    int x = 0;
+    while( x < surface->w )
+    {
+      Uint32 alpha = row[ x ] & alphaMask;
+      if( alpha == 0 )
+      {
+        x++;
+        continue;
+      }
+
+      // span goes while pixels stay all opaque or all translucent
+      Span span;
+      span.x = x;
+      span.pixel = sprite._pixels.size();
+      span.opaque = (alpha == alphaMask);
+
+      while( x < surface->w && (row[ x ] & alphaMask) != 0
+             && ((row[ x ] & alphaMask) == alphaMask) == span.opaque )
+      {
+        sprite._pixels.push_back( row[ x ] );
+        x++;
+      }
+
+      span.length = x - span.x;
+      sprite._spans.push_back( span );
+    }
+  }
+  SDL_UnlockSurface( surface );
+
+  sprite._rows.push_back( sprite._spans.size() );
+
+  return ret;
+}
+
+bool RleSprite::draw( SDL_Surface* target, const Rect& srcRect, int x, int y ) const
+{
+  SDL_PixelFormat* format = target->format;
+  if( format->BytesPerPixel != 4 || format->Rmask != _rmask || format->Gmask != _gmask
+      || format->Bmask != _bmask || (format->Amask != 0 && format->Amask != _amask) )
+  {
+    return false;
+  }
+
+  // part of sprite inside the source rect
+  int srcLeft = math::clamp( srcRect.getLeft(), 0, _size.getWidth() );
+  int srcTop = math::clamp( srcRect.getTop(), 0, _size.getHeight() );
+  int srcRight = math::clamp( srcRect.getRight(), 0, _size.getWidth() );
+  int srcBottom = math::clamp( srcRect.getBottom(), 0, _size.getHeight() );
+  x += srcLeft - srcRect.getLeft();
+  y += srcTop - srcRect.getTop();
+
+  // and inside the clip rect of target
+  const SDL_Rect& clip = target->clip_rect;
+  int left = std::max<int>( x, clip.x );
+  int top = std::max<int>( y, clip.y );
+  int right = std::min<int>( x + srcRight - srcLeft, clip.x + clip.w );
+  int bottom = std::min<int>( y + srcBottom - srcTop, clip.y + clip.h );
+
+  if( left >= right || top >= bottom )
+  {
+    return true;
+  }
+
+  // sprite coordinates of the visible part
+  const int dx = x - srcLeft;
+  const int dy = y - srcTop;
+  const int visibleLeft = left - dx;
+  const int visibleRight = right - dx;
+  const bool keepAlpha = format->Amask != 0;
+
+  if( SDL_MUSTLOCK( target ) )
+  {
+    SDL_LockSurface( target );
+  }
+
+  for( int row=top; row < bottom; row++ )
+  {
+    Uint32* dst = (Uint32*)( (Uint8*)target->pixels + row * target->pitch ) + dx;
+    const int spriteRow = row - dy;
+
+    for( unsigned int k=_rows[ spriteRow ]; k < _rows[ spriteRow + 1 ]; k++ )
+    {
+      const Span& span = _spans[ k ];
+      int start = std::max<int>( span.x, visibleLeft );
+      int end = std::min<int>( span.x + span.length, visibleRight );
+
+      if( span.x >= visibleRight )
+        break;
+
+      if( start >= end )
+        continue;
+
+      const unsigned int* src = &_pixels[ span.pixel + start - span.x ];
+      Uint32* out = dst + start;
+      const int count = end - start;
+
+      if( span.opaque && !keepAlpha )
+      {
+        memcpy( out, src, count * sizeof( Uint32 ) );
+      }
+      else if( span.opaque )
+      {
+        for( int i=0; i < count; i++ )
+        {
+          out[ i ] = (src[ i ] & ~alphaMask) | (out[ i ] & alphaMask);
+        }
+      }
+      else
+      {
+        for( int i=0; i < count; i++ )
+        {
+          out[ i ] = blend( src[ i ], out[ i ] );
+        }
+      }
+    }
+  }
+
+  if( SDL_MUSTLOCK( target ) )
+  {
+    SDL_UnlockSurface( target );
+  }
+
+  return true;
+}
+
+SDL_Surface* RleSprite::getSurface() const
+{
+  if( _surface )
+  {
+    return _surface;
+  }
+
+  _surface = SDL_CreateRGBSurface( SDL_SWSURFACE, _size.getWidth(), _size.getHeight(), 32,
+                                   _rmask, _gmask, _bmask, _amask );
+  if( _surface == 0 )
+  {
+    return 0;
+  }
+
+  SDL_FillRect( _surface, NULL, 0 );
+  SDL_LockSurface( _surface );
+  for( int y=0; y < _size.getHeight(); y++ )
+  {
+    Uint32* row = (Uint32*)( (Uint8*)_surface->pixels + y * _surface->pitch );
+    for( unsigned int k=_rows[ y ]; k < _rows[ y + 1 ]; k++ )
+    {
+      const Span& span = _spans[ k ];
+      memcpy( row + span.x, &_pixels[ span.pixel ], span.length * sizeof( Uint32 ) );
+    }
+  }
+  SDL_UnlockSurface( _surface );
+
+  return _surface;
+}
+
+SDL_Surface* RleSprite::takeSurface()
+{
+  SDL_Surface* ret = getSurface();
+  _surface = 0;
+
+  return ret;
+}
+
+Size RleSprite::getSize() const
+{
+  return _size;
+}
+
+unsigned int RleSprite::getMemorySize() const
+{
+  return _pixels.size() * sizeof( unsigned int ) + _spans.size() * sizeof( Span )
+         + _rows.size() * sizeof( unsigned int );
+}
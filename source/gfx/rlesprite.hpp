@@ -0,0 +1,76 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __OPENCAESAR3_RLESPRITE_H_INCLUDED__
+#define __OPENCAESAR3_RLESPRITE_H_INCLUDED__
+
+#include "core/referencecounted.hpp"
+#include "core/smartptr.hpp"
+#include "core/size.hpp"
+#include <vector>
+
+struct SDL_Surface;
+class Rect;
+class RleSprite;
+typedef SmartPtr< RleSprite > RleSpritePtr;
+
+//! 32bit picture stored as rows of non transparent spans.
+/** Fully transparent pixels are not stored and are skipped while drawing,
+opaque spans are copied as is, translucent spans are blended. Works with
+surfaces that keep alpha in the high byte, other formats are not encoded. */
+class RleSprite : public ReferenceCounted
+{
+public:
+  //! returns null pointer when surface can't be encoded
+  static RleSpritePtr create( SDL_Surface* surface );
+
+  virtual ~RleSprite();
+
+  //! draws srcRect part of sprite to pos, clipped by target clip rect;
+  //! returns false when target format doesn't fit, nothing is drawn then
+  bool draw( SDL_Surface* target, const Rect& srcRect, int x, int y ) const;
+
+  //! surface with same pixels, decoded on first request;
+  //! sprite keeps it and frees it on destruction
+  SDL_Surface* getSurface() const;
+
+  //! decoded surface given to caller, sprite doesn't free it anymore
+  SDL_Surface* takeSurface();
+
+  Size getSize() const;
+
+  //! bytes taken by spans and pixels
+  unsigned int getMemorySize() const;
+
+private:
+  RleSprite();
+
+  struct Span
+  {
+    unsigned short x;
+    unsigned short length;
+    unsigned int pixel;  // index of first pixel
+    bool opaque;
+  };
+
+  Size _size;
+  unsigned int _rmask, _gmask, _bmask, _amask;
+  std::vector< unsigned int > _pixels;
+  std::vector< Span > _spans;
+  std::vector< unsigned int > _rows;  // index of first span of every row, last one is end
+  mutable SDL_Surface* _surface;
+};
+
+#endif //__OPENCAESAR3_RLESPRITE_H_INCLUDED__
@@ -41,6 +41,11 @@ class GfxSdlEngine::Impl
 public:
   Picture screen;
   Picture maskedPic;
+
+  // offscreen picture which gets pictures instead of screen
+  Picture* target;
+  Point targetOffset;
+  Rect targetClip;
   
   int rmask, gmask, bmask, amask;
   unsigned int fps, lastFps;
@@ -57,6 +62,7 @@ Picture& GfxSdlEngine::getScreen()
 
 GfxSdlEngine::GfxSdlEngine() : GfxEngine(), _d( new Impl )
 {
+  _d->target = 0;
   resetTileDrawMask();
 }
 
@@ -156,26 +162,36 @@ void GfxSdlEngine::drawPicture(const Picture &picture, const int dx, const int d
   if( !picture.isValid() )
       return;
 
-  if( clipRect != 0 )
+  Picture& canvas = _d->target ? *_d->target : _d->screen;
+  Point offset = _d->target ? _d->targetOffset : Point( 0, 0 );
+  bool useClip = (clipRect != 0 || _d->target != 0);
+
+  if( useClip )
   {
-    SDL_Rect r = { (short)clipRect->getLeft(), (short)clipRect->getTop(), (Uint16)clipRect->getWidth(), (Uint16)clipRect->getHeight() };
-    SDL_SetClipRect( _d->screen.getSurface(), &r );
+    Rect clip = _d->target ? _d->targetClip : *clipRect - offset;
+    if( _d->target && clipRect != 0 )
+    {
+      clip.clipAgainst( *clipRect - offset );
+    }
+
+    SDL_Rect r = { (short)clip.getLeft(), (short)clip.getTop(), (Uint16)clip.getWidth(), (Uint16)clip.getHeight() };
+    SDL_SetClipRect( canvas.getSurface(), &r );
   }
 
   if( _d->rmask || _d->gmask || _d->bmask  )
   {
     PictureConverter::maskColor( _d->maskedPic, picture, _d->rmask, _d->gmask, _d->bmask, _d->amask );
 
-    _d->screen.draw( _d->maskedPic, dx, dy );
+    canvas.draw( _d->maskedPic, dx - offset.getX(), dy - offset.getY() );
   }
   else
   {
-    _d->screen.draw( picture, dx, dy );
+    canvas.draw( picture, dx - offset.getX(), dy - offset.getY() );
   }
 
-  if( clipRect != 0 )
+  if( useClip )
   {
-    SDL_SetClipRect( _d->screen.getSurface(), 0 );
+    SDL_SetClipRect( canvas.getSurface(), 0 );
   }
 }
 
@@ -197,6 +213,20 @@ void GfxSdlEngine::resetTileDrawMask()
   _d->rmask = _d->gmask = _d->bmask = _d->amask = 0;
 }
 
+bool GfxSdlEngine::setRenderTarget( Picture* target, const Point& offset, const Rect& clip )
+{
+  _d->target = target;
+  _d->targetOffset = offset;
+  _d->targetClip = clip;
+
+  return true;
+}
+
+void GfxSdlEngine::resetRenderTarget()
+{
+  _d->target = 0;
+}
+
 Picture* GfxSdlEngine::createPicture(const Size& size )
 {
   SDL_Surface* img;
@@ -44,6 +44,9 @@ public:
   virtual void setTileDrawMask( int rmask, int gmask, int bmask, int amask );
   virtual void resetTileDrawMask();
 
+  virtual bool setRenderTarget( Picture* target, const Point& offset, const Rect& clip );
+  virtual void resetRenderTarget();
+
   // deletes a picture (deallocate memory)
   virtual void deletePicture( Picture* pic );
   virtual void loadPicture(Picture &ioPicture);
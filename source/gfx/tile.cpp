@@ -20,38 +20,72 @@
 #include "game/resourcegroup.hpp"
 #include "core/stringhelper.hpp"
 
-void Tile::Terrain::reset()
+namespace
 {
-  clearFlags();
-  desirability = 0;
-  watersrvc = 0;
+  inline unsigned short flagBit( Tile::Type type ) { return 1 << type; }
+
+  const unsigned short terrainFlags = (1 << Tile::isConstructible) - 1;
+  // elevation stays when terrain is cleared
+  const unsigned short clearedFlags = terrainFlags & ~flagBit( Tile::tlElevation );
+  const unsigned short notConstructible = flagBit( Tile::tlWater ) | flagBit( Tile::tlRock ) | flagBit( Tile::tlTree )
+                                          | flagBit( Tile::tlBuilding ) | flagBit( Tile::tlRoad );
+  const unsigned short destructible = flagBit( Tile::tlTree ) | flagBit( Tile::tlBuilding ) | flagBit( Tile::tlRoad );
+  const unsigned short notFlat = flagBit( Tile::tlRock ) | flagBit( Tile::tlTree ) | flagBit( Tile::tlBuilding )
+                                 | flagBit( Tile::tlAqueduct );
+  const unsigned short notLand = flagBit( Tile::tlWater ) | flagBit( Tile::tlTree ) | flagBit( Tile::tlRock );
+
+  const Animation invalidAnimation;
 }
 
-void Tile::Terrain::clearFlags()
+void Tile::Terrain::reset()
 {
-  water      = false;
-  rock       = false;
-  tree       = false;
-  building   = false;
-  road       = false;
-  aqueduct   = false;
-  garden     = false;
-  meadow     = false;
-  wall       = false;
-  gatehouse  = false;
+  flags = 0;
+  desirability = 0;
+  watersrvc = 0;
 }
 
 Tile::Tile( const TilePos& pos) //: _terrain( 0, 0, 0, 0, 0, 0 )
 {
   _pos = pos;
   _picture = NULL;
-  _wasDrawn = false;
   _master = NULL;
   _overlay = NULL;
+  _animation = NULL;
   _terrain.reset();
   _terrain.imgid = 0;
 }
 
+Tile::Tile( const Tile& other ) : _animation( NULL )
+{
+  *this = other;
+}
+
+Tile::~Tile()
+{
+  delete _animation;
+}
+
+Tile& Tile::operator=( const Tile& other )
+{
+  _terrain = other._terrain;
+  _picture = other._picture;
+  _overlay = other._overlay;
+  _master = other._master;
+  _pos = other._pos;
+
+  if( other._animation )
+  {
+    setAnimation( *other._animation );
+  }
+  else
+  {
+    delete _animation;
+    _animation = NULL;
+  }
+
+  return *this;
+}
+
 int Tile::getI() const    {   return _pos.getI();   }
 
 int Tile::getJ() const    {   return _pos.getJ();   }
@@ -91,7 +125,7 @@ void Tile::setMasterTile(Tile* master)
 
 bool Tile::isFlat() const
 {
-  return !(_terrain.rock || _terrain.tree || _terrain.building || _terrain.aqueduct);
+  return (_terrain.flags & notFlat) == 0;
 }
 
 TilePos Tile::getIJ() const
@@ -111,29 +145,37 @@ Point Tile::getXY() const
 
 void Tile::animate(unsigned int time)
 {
-  if( _overlay.isNull() && _animation.isValid() )
+  if( _animation && _overlay.isNull() && _animation->isValid() )
   {
-    _animation.update( time );
+    _animation->update( time );
   }
 }
 
-const Animation&Tile::getAnimation() const
+const Animation& Tile::getAnimation() const
 {
-  return _animation;
+  return _animation ? *_animation : invalidAnimation;
 }
 
 void Tile::setAnimation(const Animation& animation)
 {
-  _animation = animation;
+  if( _animation )
+  {
+    *_animation = animation;
+  }
+  else
+  {
+    _animation = new Animation( animation );
+  }
 }
 
 bool Tile::isWalkable( bool alllands ) const
 {
   // TODO: test building to allow garden, gatehouse, granary, ...
-  bool walkable = (_terrain.road || (alllands && !_terrain.water && !_terrain.tree && !_terrain.rock));
-  if( _overlay.isValid() )
+  bool walkable = (_terrain.flags & flagBit( tlRoad ))
+                  || (alllands && (_terrain.flags & notLand) == 0);
+  if( walkable && _overlay.isValid() )
   {
-    walkable &= _overlay->isWalkable();
+    walkable = _overlay->isWalkable();
   }
 
   return walkable;
@@ -143,56 +185,45 @@ bool Tile::getFlag(Tile::Type type) const
 {
   switch( type )
   {
-  case tlRoad: return _terrain.road;
-  case tlWater: return _terrain.water;
-  case tlTree: return _terrain.tree;
-  case isConstructible:
-  {
-    return !(_terrain.water || _terrain.rock || _terrain.tree || _terrain.building || _terrain.road);
-  }
-  case tlMeadow: return _terrain.meadow;
-  case tlRock: return _terrain.rock;
-  case tlBuilding: return _terrain.building;
-  case tlAqueduct: return _terrain.aqueduct;
-  case isDestructible:
-  {
-    return (_terrain.tree || _terrain.building || _terrain.road);
-  }
-  case tlGarden: return _terrain.garden;
-  case tlElevation: return _terrain.elevation;
-  case tlWall: return _terrain.wall;
-  case tlGateHouse: return _terrain.gatehouse;
-  case wasDrawn: return _wasDrawn;
+  case isConstructible: return (_terrain.flags & notConstructible) == 0;
+  case isDestructible: return (_terrain.flags & destructible) != 0;
+  case clearAll: return false;
   default: break;
   }
 
-  return false;
+  return (_terrain.flags & flagBit( type )) != 0;
 }
 
 void Tile::setFlag(Tile::Type type, bool value)
 {
   switch( type )
   {
-  case tlRoad: _terrain.road = value; break;
-  case tlWater: _terrain.water = value; break;
-  case tlTree: _terrain.tree = value; break;
-  case tlMeadow: _terrain.meadow = value; break;
-  case tlRock: _terrain.rock = value; break;
-  case tlBuilding: _terrain.building = value; break;
-  case tlAqueduct: _terrain.aqueduct = value; break;
-  case tlGarden: _terrain.garden = value; break;
-  case tlElevation: _terrain.elevation = value; break;
-  case clearAll: _terrain.clearFlags(); break;
-  case tlWall: _terrain.wall = value; break;
-  case tlGateHouse: _terrain.gatehouse = value; break;
-  case wasDrawn: _wasDrawn = value; break;
-  default: break;
+  case isConstructible:
+  case isDestructible:
+  break;
+
+  case clearAll: _terrain.flags = (_terrain.flags & ~clearedFlags) | flagBit( wasChanged ); break;
+
+  default:
+    if( value ) { _terrain.flags |= flagBit( type ); }
+    else        { _terrain.flags &= ~flagBit( type ); }
+
+    if( type < isConstructible )
+    {
+      _terrain.flags |= flagBit( wasChanged );
+    }
+  break;
   }
 }
 
 void Tile::appendDesirability(int value)
 {
-   _terrain.desirability = math::clamp( _terrain.desirability += value, -0xff, 0xff );
+   _terrain.desirability = math::clamp( _terrain.desirability + value, -0xff, 0xff );
+}
+
+void Tile::setDesirability(int value)
+{
+  _terrain.desirability = math::clamp( value, -0xff, 0xff );
 }
 
 int Tile::getDesirability() const
@@ -208,6 +239,7 @@ TileOverlayPtr Tile::getOverlay() const
 void Tile::setOverlay(TileOverlayPtr overlay)
 {
   _overlay = overlay;
+  _terrain.flags |= flagBit( wasChanged );
 }
 
 unsigned int Tile::getOriginalImgId() const
@@ -26,39 +26,33 @@ class Picture;
 // a Tile in the Tilemap
 class Tile
 {
+  // terrain flags take one bit per Type, so frequently read fields
+  // of tile fit together into eight bytes
   struct Terrain
   {
-    bool water;
-    bool rock;
-    bool tree;
-    bool building;
-    bool road;
-    bool garden;
-    bool aqueduct;
-    bool meadow;
-    bool elevation;
-    bool wall;
-    bool gatehouse;
-    int  desirability;
-    int  watersrvc;
+    unsigned short flags;
+    short desirability;
+    unsigned short watersrvc;  // four bits per water service
 
     /*
      * original tile information
      */
-    unsigned short int imgid;
-    unsigned short int terraininfo;
+    unsigned short imgid;
 
     void reset();
-    void clearFlags();
   };
 
 public:
   typedef enum { tlRoad=0, tlWater, tlTree, tlMeadow, tlRock, tlBuilding, tlAqueduct,
                  tlGarden, tlElevation, tlWall, tlGateHouse,
                  isConstructible, isDestructible, clearAll,
-                 wasDrawn } Type;
+                 wasDrawn, wasChanged } Type;
 
   Tile(const TilePos& pos);
+  Tile(const Tile& other);
+  ~Tile();
+
+  Tile& operator=(const Tile& other);
 
   // tile coordinates
   int getI() const;
@@ -83,19 +77,23 @@ public:
   //TerrainTile& getTerrain();
   bool isFlat() const;  // returns true if the tile is walkable/boatable (for display purpose)
 
-  void resetWasDrawn() { _wasDrawn = false; }
-  void setWasDrawn()   { _wasDrawn = true;  }
+  void resetWasDrawn() { _terrain.flags &= ~(1 << wasDrawn); }
+  void setWasDrawn()   { _terrain.flags |= (1 << wasDrawn);  }
 
   void animate( unsigned int time );
 
+  // only water tiles are animated, animation is allocated for them alone
   const Animation& getAnimation() const;
   void setAnimation( const Animation& animation );
 
   bool isWalkable( bool ) const;
+
+  // terrain flags and overlay raise wasChanged, minimap clears it after redraw
   bool getFlag( Type type ) const;
   void setFlag( Type type, bool value );
 
   void appendDesirability( int value );
+  void setDesirability( int value );
   int getDesirability() const;
   TileOverlayPtr getOverlay() const;
   void setOverlay( TileOverlayPtr overlay );
@@ -107,13 +105,12 @@ public:
   int getWaterService( const WaterService type ) const;
 
 private:
-  TilePos _pos; // coordinates of the tile
-  Tile* _master;  // left-most tile if multi-tile, or "this" if single-tile
   Terrain _terrain;    // infos about the tile (building, tree, road, water, rock...)
   Picture const* _picture; // displayed picture
-  bool _wasDrawn;
-  Animation _animation;
   TileOverlayPtr _overlay;
+  Tile* _master;  // left-most tile if multi-tile, or "this" if single-tile
+  TilePos _pos; // coordinates of the tile
+  Animation* _animation;  // null for tiles without animation
 };
 
 class TileHelper
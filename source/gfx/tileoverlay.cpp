@@ -18,6 +18,7 @@
 #include "game/city.hpp"
 #include "game/tilemap.hpp"
 #include "core/logger.hpp"
+#include <vector>
 
 namespace {
 static Renderer::PassQueue defaultPassQueue=Renderer::PassQueue(1,Renderer::foreground);
@@ -37,6 +38,26 @@ public:
   Animation animation;  // basic animation (if any)
   bool isDeleted;
   CityPtr city;
+
+  struct Periodic
+  {
+    unsigned int period;
+    Delegate0<void> slot;
+    TimerPtr timer;
+  };
+
+  typedef std::vector< Periodic > PeriodicList;
+  PeriodicList periodics;
+
+  void stopPeriodics()
+  {
+    for( PeriodicList::iterator it=periodics.begin(); it != periodics.end(); it++ )
+    {
+      it->timer->destroy();
+    }
+
+    periodics.clear();
+  }
 };
 
 TileOverlay::TileOverlay(const Type type, const Size& size)
@@ -52,7 +73,7 @@ TileOverlay::TileOverlay(const Type type, const Size& size)
 
 TileOverlay::~TileOverlay()
 {
-  // what we shall to do here?
+  _d->stopPeriodics();
 }
 
 
@@ -72,6 +93,8 @@ void TileOverlay::setType(const Type type)
 
 void TileOverlay::timeStep(const unsigned long time) {}
 
+void TileOverlay::think() {}
+
 void TileOverlay::setPicture(Picture picture)
 {
   _d->picture = picture;
@@ -108,6 +131,15 @@ void TileOverlay::setAnimation(const Animation& animation)
   _d->animation = animation;
 }
 
+bool TileOverlay::isAnimated() const
+{
+  return _d->animation.isValid();
+}
+
+void TileOverlay::animate( unsigned int time )
+{
+}
+
 void TileOverlay::build( CityPtr city, const TilePos& pos )
 {
   Tilemap &tilemap = city->getTilemap();
@@ -137,10 +169,33 @@ void TileOverlay::build( CityPtr city, const TilePos& pos )
 void TileOverlay::deleteLater()
 {
   _d->isDeleted  = true;
+  _d->stopPeriodics();
 }
 
 void TileOverlay::destroy()
 {
+  _d->stopPeriodics();
+}
+
+void TileOverlay::_addPeriodic( unsigned int period, Delegate0<void> slot )
+{
+  // build() is called again on load, slot must not be called twice
+  for( Impl::PeriodicList::iterator it=_d->periodics.begin(); it != _d->periodics.end(); it++ )
+  {
+    if( it->period == period && it->slot == slot )
+    {
+      return;
+    }
+  }
+
+  TilePos pos = getTilePos();
+  Impl::Periodic periodic;
+  periodic.period = period;
+  periodic.slot = slot;
+  periodic.timer = Timer::createPeriodic( period, pos.getI() * 7 + pos.getJ() * 13 );
+  periodic.timer->onTimeout().connect( slot );
+
+  _d->periodics.push_back( periodic );
 }
 
 Tile& TileOverlay::getTile() const
@@ -23,6 +23,7 @@
 #include "core/serializer.hpp"
 #include "core/scopedptr.hpp"
 #include "renderer.hpp"
+#include "game/timer.hpp"
 
 class TileOverlay : public Serializable, public ReferenceCounted
 {
@@ -50,12 +51,20 @@ public:
   virtual Point getOffset( const Point& subpos ) const;
   virtual void timeStep(const unsigned long time);  // perform one simulation step
 
+  // read-only part of next timeStep(), city calls it for all overlays at once
+  // from several threads, so it may write only intent which timeStep() applies
+  virtual void think();
+
+  // advances animation frames, renderer calls it for visible overlays only
+  virtual void animate( unsigned int time );
+
   // graphic
   void setPicture(Picture picture);
   void setPicture(const char* resource, const int index);
   const Picture& getPicture() const;
 
   void setAnimation( const Animation& animation );
+  bool isAnimated() const;
 
   virtual const PicturesArray& getPictures( Renderer::Pass pass ) const;
   virtual Renderer::PassQueue getPassQueue() const;
@@ -77,6 +86,16 @@ protected:
   PicturesArray& _getFgPictures();
   Picture& _getPicture();
 
+  // calls slot once in period ticks while overlay is built, phase depends on
+  // tile position, so same overlays around do this work on different ticks
+  void _addPeriodic( unsigned int period, Delegate0<void> slot );
+
+  template< class T >
+  void _addPeriodic( unsigned int period, T* obj, void (T::*slot)() )
+  {
+    _addPeriodic( period, Delegate0<void>( obj, slot ) );
+  }
+
 private:
   class Impl;
   ScopedPtr< Impl > _d;
@@ -133,6 +133,11 @@ void ContextMenuItem::setIsSeparator( bool isSepar )
 
 void ContextMenuItem::setHovered( bool hover )
 {
+  if( _d->isHovered != hover )
+  {
+    invalidate();
+  }
+
   _d->isHovered = hover;
 }
 
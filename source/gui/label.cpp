@@ -577,6 +577,7 @@ void Label::beforeDraw( GfxEngine& painter )
   if( _d->needUpdatePicture )
   {
     _updateTexture( painter );
+    invalidate();
 
     _d->needUpdatePicture = false;		
   }
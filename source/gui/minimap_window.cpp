@@ -15,12 +15,15 @@
 
 #include "minimap_window.hpp"
 #include "game/tilemap.hpp"
+#include "game/city.hpp"
 #include "game/minimap_colours.hpp"
 #include "gfx/tile.hpp"
 #include "gfx/tileoverlay.hpp"
 #include "core/time.hpp"
 #include "gfx/engine.hpp"
 #include "building/constants.hpp"
+#include "walker/walker.hpp"
+#include "walker/constants.hpp"
 
 using namespace constants;
 
@@ -31,10 +34,11 @@ class Minimap::Impl
 {
 public:
   PictureRef minimap;
-  PictureRef fullmap;
+  PictureRef fullmap;  // two pixels per tile, redrawn for changed tiles only
 
-  Tilemap const* tilemap;
-  int climate;
+  CityPtr city;
+  Tilemap* tilemap;
+  bool fullmapReady;
 
   MinimapColors* colors;
 
@@ -43,18 +47,21 @@ public:
 
   void getTerrainColours(const Tile& tile, int &c1, int &c2);
   void getBuildingColours(const Tile& tile, int &c1, int &c2);
+  void updateFullmap();
+  void drawWalkers( const Point& offset );
   void updateImage();
 };
 
-Minimap::Minimap(Widget* parent, const Rect& rect, const Tilemap& tilemap, int climate)
+Minimap::Minimap(Widget* parent, const Rect& rect, CityPtr city )
   : Widget( parent, -1, rect ), _d( new Impl )
 {
-  _d->tilemap = &tilemap;
-  _d->climate = climate;
+  _d->city = city;
+  _d->tilemap = &city->getTilemap();
+  _d->fullmapReady = false;
   _d->lastTimeUpdate = 0;
   _d->fullmap.reset( Picture::create( Size( _d->tilemap->getSize() * 2 ) ) );
   _d->minimap.reset( Picture::create( Size( 144, 110 ) ) );
-  _d->colors = new MinimapColors( (ClimateType)climate );
+  _d->colors = new MinimapColors( city->getClimate() );
 }
 
 Point getBitmapCoordinates(int x, int y, int mapsize )
@@ -177,67 +184,92 @@ void Minimap::Impl::getBuildingColours(const Tile& tile, int &c1, int &c2)
   c2 |= 0xff000000;
 }
 
-void Minimap::Impl::updateImage()
+void Minimap::Impl::updateFullmap()
 {
   int mapsize = tilemap->getSize();
+  bool locked = false;
 
-  fullmap->lock();
-  // here we can draw anything
-
-  // std::cout << "center is (" << _mapArea->getCenterX() << "," << _mapArea->getCenterZ() << ")" << std::endl;
-
-  int border = (162 - mapsize) / 2;
-  int max = border + mapsize;
-
-  for (int y = border; y < max; y++)
+  for( int i=0; i < mapsize; i++ )
   {
-    for (int x = border; x < max; x++)
+    for( int j=0; j < mapsize; j++ )
     {
-      const Tile& tile = tilemap->at(x - border, y - border);
+      Tile& tile = tilemap->at( i, j );
 
-      Point pnt = getBitmapCoordinates(x - border, y - border, mapsize);
-      int c1, c2;
-      getTerrainColours( tile, c1, c2);
+      // terrain and buildings rarely change, only changed tiles are redrawn
+      if( fullmapReady && !tile.getFlag( Tile::wasChanged ) )
+        continue;
+
+      tile.setFlag( Tile::wasChanged, false );
 
+      Point pnt = getBitmapCoordinates( i, j, mapsize );
       if( pnt.getX() >= fullmap->getWidth()-1 || pnt.getY() >= fullmap->getHeight() )
         continue;
 
-      fullmap->setPixel( pnt, c1);
-      fullmap->setPixel( pnt + Point( 1, 0 ), c2);
-    }
-  }
+      if( !locked )
+      {
+        fullmap->lock();
+        locked = true;
+      }
 
-  // show center of screen on minimap
-  // Exit out of image size on small carts... please fix it
+      int c1, c2;
+      getTerrainColours( tile, c1, c2 );
 
-  /*sdlFacade.setPixel(surface, TilemapRenderer::instance().getMapArea().getCenterX(),     mapsize * 2 - TilemapRenderer::instance().getMapArea().getCenterZ(), kWhite);
-  sdlFacade.setPixel(surface, TilemapRenderer::instance().getMapArea().getCenterX() + 1, mapsize * 2 - TilemapRenderer::instance().getMapArea().getCenterZ(), kWhite);
-  sdlFacade.setPixel(surface, TilemapRenderer::instance().getMapArea().getCenterX(),     mapsize * 2 - TilemapRenderer::instance().getMapArea().getCenterZ() + 1, kWhite);
-  sdlFacade.setPixel(surface, TilemapRenderer::instance().getMapArea().getCenterX() + 1, mapsize * 2 - TilemapRenderer::instance().getMapArea().getCenterZ() + 1, kWhite);
+      fullmap->setPixel( pnt, c1 );
+      fullmap->setPixel( pnt + Point( 1, 0 ), c2 );
+    }
+  }
 
-  for ( int i = TilemapRenderer::instance().getMapArea().getCenterX() - 18; i <= TilemapRenderer::instance().getMapArea().getCenterX() + 18; i++ )
+  if( locked )
   {
-    sdlFacade.setPixel(surface, i, mapsize * 2 - TilemapRenderer::instance().getMapArea().getCenterZ() + 34, kYellow);
-    sdlFacade.setPixel(surface, i, mapsize * 2 - TilemapRenderer::instance().getMapArea().getCenterZ() - 34, kYellow);
+    fullmap->unlock();
   }
 
-  for ( int j = mapsize * 2 - TilemapRenderer::instance().getMapArea().getCenterZ() - 34; j <= mapsize * 2 - TilemapRenderer::instance().getMapArea().getCenterZ() + 34; j++ )
+  fullmapReady = true;
+}
+
+void Minimap::Impl::drawWalkers( const Point& offset )
+{
+  // walkers are dots over copy of fullmap, so they never spoil it
+  int mapsize = tilemap->getSize();
+
+  WalkerList walkers = city->getWalkers( walker::all );
+
+  minimap->lock();
+  for( WalkerList::iterator it=walkers.begin(); it != walkers.end(); it++ )
   {
-    sdlFacade.setPixel(surface, TilemapRenderer::instance().getMapArea().getCenterX() - 18, j, kYellow);
-    sdlFacade.setPixel(surface, TilemapRenderer::instance().getMapArea().getCenterX() + 18, j, kYellow);
-  }
-  */
+    int colour = 0;
+    switch( (*it)->getType() )
+    {
+    case walker::soldier: colour = colors->colour( MinimapColors::MAP_SPRITES, MinimapColors::SPRITE_SOLDIER ); break;
+    default: continue;
+    }
 
-  fullmap->unlock();
+    TilePos pos = (*it)->getIJ();
+    Point pnt = getBitmapCoordinates( pos.getI(), pos.getJ(), mapsize ) + offset;
+    if( pnt.getX() < 0 || pnt.getY() < 0 || pnt.getX() >= minimap->getWidth()-1 || pnt.getY() >= minimap->getHeight() )
+      continue;
 
-  // this is window where minimap is displayed
+    minimap->setPixel( pnt, colour | 0xff000000 );
+    minimap->setPixel( pnt + Point( 1, 0 ), colour | 0xff000000 );
+  }
+  minimap->unlock();
+}
 
+void Minimap::Impl::updateImage()
+{
+  int mapsize = tilemap->getSize();
 
+  updateFullmap();
+
+  // this is window where minimap is displayed
   int i = center.getX();
   int j = center.getY();
+  Point offset( 146/2 - i, 112/2 + j - mapsize*2 );
 
   minimap->fill( 0xff000000, Rect() );
-  minimap->draw( *fullmap, 146/2 - i, 112/2 + j - mapsize*2 );
+  minimap->draw( *fullmap, offset.getX(), offset.getY() );
+
+  drawWalkers( offset );
 }
 
 /* end of helper functions */
@@ -252,15 +284,21 @@ void Minimap::draw(GfxEngine& painter)
   if( !isVisible() )
     return;
 
-  if( DateTime::getElapsedTime() - _d->lastTimeUpdate > 500 )
+  painter.drawPicture( *_d->minimap, getScreenLeft(), getScreenTop() ); // 152, 145
+
+  Widget::draw( painter );
+}
+
+void Minimap::beforeDraw( GfxEngine& painter )
+{
+  if( isVisible() && DateTime::getElapsedTime() - _d->lastTimeUpdate > 500 )
   {
     _d->updateImage();
     _d->lastTimeUpdate = DateTime::getElapsedTime();
+    invalidate();
   }
 
-  painter.drawPicture( *_d->minimap, getScreenLeft(), getScreenTop() ); // 152, 145
-
-  Widget::draw( painter );
+  Widget::beforeDraw( painter );
 }
 
 void Minimap::setCenter( Point pos)
@@ -19,8 +19,7 @@
 #include "widget.hpp"
 #include "core/scopedptr.hpp"
 #include "gfx/picture.hpp"
-
-class Tilemap;
+#include "core/predefinitions.hpp"
 
 namespace gui
 {
@@ -28,9 +27,10 @@ namespace gui
 class Minimap : public Widget
 {
 public:
-  Minimap(Widget* parent, const Rect& rect, const Tilemap& tilemap, int climate );
+  Minimap(Widget* parent, const Rect& rect, CityPtr city );
 
   void draw(GfxEngine &painter);
+  void beforeDraw( GfxEngine& painter );
 
   void setCenter( Point pos );
 
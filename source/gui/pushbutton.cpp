@@ -136,6 +136,8 @@ PushButton::PushButton( Widget* parent,
 
 void PushButton::_updateTexture( ElementState state )
 {
+  invalidate();
+
   Size btnSize = getSize();
   PictureRef& curTxs = _d->buttonStates[ state ].background;
   PictureRef& textTxs = _d->buttonStates[ state ].textPicture;
@@ -432,7 +434,13 @@ void PushButton::beforeDraw( GfxEngine& painter )
   // todo:	move sprite up and text down if the pressed state has a sprite
   // draw sprites for focused and mouse-over 
   // Point spritePos = AbsoluteRect.getCenter();
-  _d->currentButtonState = _getActiveButtonState();
+  ElementState state = _getActiveButtonState();
+  if( state != _d->currentButtonState )
+  {
+    invalidate();
+  }
+
+  _d->currentButtonState = state;
 
   if( !_d->buttonStates[ _d->currentButtonState ].background )
   {
@@ -70,13 +70,19 @@ void TopMenu::draw( GfxEngine& engine )
   if( !isVisible() )
     return;
 
-  _d->updateDate();
-
   engine.drawPicture( *_d->bgPicture, getScreenLeft(), getScreenTop() );
 
   MainMenu::draw( engine );
 }
 
+void TopMenu::beforeDraw( GfxEngine& painter )
+{
+  // date label changes before layer of menu is composed
+  _d->updateDate();
+
+  MainMenu::beforeDraw( painter );
+}
+
 void TopMenu::setPopulation( int value )
 {
   if( _d->lbPopulation )
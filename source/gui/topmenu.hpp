@@ -31,6 +31,7 @@ public:
 
   // draw on screen
   void draw( GfxEngine& engine );
+  void beforeDraw( GfxEngine& painter );
 
   void setFunds( int value );
   void setPopulation( int value );
@@ -21,10 +21,38 @@
 #include "core/saveadapter.hpp"
 #include "core/stringhelper.hpp"
 #include "core/logger.hpp"
+#include "core/color.hpp"
+#include "gfx/engine.hpp"
 
 namespace gui
 {
 
+namespace
+{
+
+// popups of element go out of its rectangle, such element can't be kept in a layer
+bool isChildrenInside( const Widget* widget, const Rect& rect )
+{
+  const Widget::Widgets& children = widget->getChildren();
+  for( Widget::ConstChildIterator it=children.begin(); it != children.end(); it++ )
+  {
+    if( !(*it)->isVisible() )
+      continue;
+
+    Rect childRect = (*it)->getAbsoluteRect();
+    if( childRect.getLeft() < rect.getLeft() || childRect.getTop() < rect.getTop()
+        || childRect.getRight() > rect.getRight() || childRect.getBottom() > rect.getBottom()
+        || !isChildrenInside( *it, rect ) )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}
+
 void Widget::beforeDraw( GfxEngine& painter )
 {
   _OC3_DEBUG_BREAK_IF( !_d->parent && "Parent must be exists" );
@@ -75,6 +103,8 @@ Widget::Widget( Widget* parent, int id, const Rect& rectangle )
   _d->absoluteRect = rectangle;
   _d->absoluteClippingRect = rectangle;
   _d->desiredRect = rectangle;
+  _d->isCached = false;
+  _d->isDamaged = false;
 
 #ifdef _DEBUG
   setDebugName( "AbstractWidget" );
@@ -85,6 +115,7 @@ Widget::Widget( Widget* parent, int id, const Rect& rectangle )
   {
     parent->addChild_(this);
     recalculateAbsolutePosition(true);
+    invalidate();
     drop();
   }
 
@@ -224,6 +255,8 @@ void Widget::updateAbsolutePosition()
 
   if( oldRect != _d->absoluteRect )
   {
+    _invalidate( oldRect );
+    invalidate();
     _resizeEvent();
   }
 
@@ -276,6 +309,7 @@ void Widget::addChild( Widget* child )
   if (child)
   {
     child->updateAbsolutePosition();
+    child->invalidate();
   }
 }
 
@@ -285,6 +319,7 @@ void Widget::removeChild( Widget* child )
   for (; it != _d->children.end(); ++it)
     if ((*it) == child)
     {
+      child->invalidate();
       (*it)->_d->parent = 0;
       (*it)->drop();
       _d->children.erase(it);
@@ -297,10 +332,101 @@ void Widget::draw( GfxEngine& painter )
   if ( isVisible() )
   {
     foreach( Widget* widget, _d->children )
-      widget->draw( painter );
+    {
+      if( widget->_d->isCached )
+        widget->_drawCached( painter );
+      else
+        widget->draw( painter );
+    }
+  }
+}
+
+void Widget::setCached( bool cached )
+{
+  _d->isCached = cached;
+  _d->cache.reset();
+  _d->isDamaged = false;
+}
+
+void Widget::invalidate()
+{
+  _invalidate( getAbsoluteRect() );
+}
+
+void Widget::_invalidate( const Rect& area )
+{
+  // every cached layer which contains element must redraw this area
+  for( Widget* widget=this; widget != 0; widget = widget->getParent() )
+  {
+    Impl& d = *widget->_d;
+    if( !d.isCached )
+      continue;
+
+    if( d.isDamaged )
+    {
+      d.damage.addInternalPoint( area.UpperLeftCorner );
+      d.damage.addInternalPoint( area.LowerRightCorner );
+    }
+    else
+    {
+      d.damage = area;
+      d.isDamaged = true;
+    }
   }
 }
 
+void Widget::_drawCached( GfxEngine& painter )
+{
+  if( !isVisible() )
+    return;
+
+  const Rect& rect = _d->absoluteRect;
+  if( _d->isDamaged && !isChildrenInside( this, rect ) )
+  {
+    // layer is composed again when popups are closed
+    _d->damage = rect;
+    draw( painter );
+    return;
+  }
+
+  if( _d->cache.isNull() || _d->cache->getSize() != rect.getSize() )
+  {
+    _d->cache.reset( Picture::create( rect.getSize() ) );
+    // layer is filled opaque before composing, screen gets plain copy of it
+    _d->cache->setOpaque( true );
+    _d->damage = rect;
+    _d->isDamaged = true;
+  }
+
+  if( _d->isDamaged )
+  {
+    Rect area = _d->damage;
+    area.clipAgainst( rect );
+    area -= rect.UpperLeftCorner;
+    _d->isDamaged = false;
+
+    if( area.getWidth() <= 0 || area.getHeight() <= 0 )
+    {
+      painter.drawPicture( *_d->cache, rect.UpperLeftCorner );
+      return;
+    }
+
+    if( !painter.setRenderTarget( _d->cache.data(), rect.UpperLeftCorner, area ) )
+    {
+      // engine draws only to screen, element stays uncached
+      setCached( false );
+      draw( painter );
+      return;
+    }
+
+    _d->cache->fill( 0xff000000, area );
+    draw( painter );
+    painter.resetRenderTarget();
+  }
+
+  painter.drawPicture( *_d->cache, rect.UpperLeftCorner );
+}
+
 bool Widget::isVisible() const
 {
   return _d->isVisible;
@@ -390,6 +516,7 @@ bool Widget::bringChildToFront( Widget* element )
     {
       _d->children.erase(it);
       _d->children.push_back(element);
+      element->invalidate();
       return true;
     }
   }
@@ -408,6 +535,7 @@ bool Widget::sendChildToBack( Widget* child )
     {
       _d->children.erase(it);
       _d->children.push_front(child);
+      child->invalidate();
       return true;
     }
   }
@@ -773,6 +901,11 @@ void Widget::remove()
 
 void Widget::setEnabled(bool enabled)
 {
+    if( _isEnabled != enabled )
+    {
+        invalidate();
+    }
+
     _isEnabled = enabled;
 }
 
@@ -813,6 +946,11 @@ bool Widget::isNotClipped() const
 
 void Widget::setVisible( bool visible )
 {
+  if( _d->isVisible != visible )
+  {
+    invalidate();
+  }
+
   _d->isVisible = visible;
 }
 
@@ -828,6 +966,11 @@ bool Widget::hasTabGroup() const
 
 void Widget::setText( const std::string& text )
 {
+  if( _d->text != text )
+  {
+    invalidate();
+  }
+
   _d->text = text;
 }
 
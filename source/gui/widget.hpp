@@ -366,6 +366,14 @@ public:
   /** \return true if the element is not clipped by its parent's clipping rectangle. */
   bool isNotClipped() const;
 
+  //! Keeps the element with its children in a cached layer, which is blitted
+  //! every frame and redrawn only in changed areas
+  /** The element must cover its rectangle with opaque pictures. */
+  void setCached( bool cached );
+
+  //! Marks area of the element as changed for cached layers it belongs to
+  void invalidate();
+
   //! Sets the maximum size allowed for this element
   /** If set to 0,0, there is no maximum size */
   void setMaxSize( const Size& size);
@@ -439,6 +447,10 @@ protected:
   // not virtual because needed in constructor
   void addChild_(Widget* child);
 
+  // draws cached layer, recomposing its damaged area first
+  void _drawCached( GfxEngine& painter );
+  void _invalidate( const Rect& area );
+
 	//FontsMap& getFonts_();
 
   // not virtual because needed in constructor
@@ -18,6 +18,7 @@
 #define __OPENCAESAR3_WIDGET_PRIVATE_H_INCLUDE_
 
 #include "widget.hpp"
+#include "gfx/picture.hpp"
 
 namespace gui
 {
@@ -69,6 +70,14 @@ public:
   std::string toolTipText;
 
   std::string text;
+
+  //! cached layer of element and its children
+  bool isCached;
+  PictureRef cache;
+
+  //! changed area of cached layer, in screen coordinates
+  bool isDamaged;
+  Rect damage;
 };
 
 }//end namespace gui
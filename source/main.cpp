@@ -21,6 +21,30 @@ int main(int argc, char* argv[])
        GameSettings::set( GameSettings::localeName, Variant( std::string( argv[i+1] ) ) );
        i++;
      }
+
+     if( !strcmp( argv[i], "-record" ) )
+     {
+       GameSettings::set( GameSettings::recordPath, Variant( std::string( argv[i+1] ) ) );
+       i++;
+     }
+
+     if( !strcmp( argv[i], "-replay" ) )
+     {
+       GameSettings::set( GameSettings::replayPath, Variant( std::string( argv[i+1] ) ) );
+       i++;
+     }
+
+     if( !strcmp( argv[i], "-rle" ) )
+     {
+       GameSettings::set( GameSettings::rleSprites, Variant( !strcmp( argv[i+1], "on" ) ) );
+       i++;
+     }
+
+     if( !strcmp( argv[i], "-c3gfx" ) )
+     {
+       GameSettings::set( GameSettings::c3gfx, Variant( std::string( argv[i+1] ) ) );
+       i++;
+     }
    }
 
    try
@@ -32,7 +56,7 @@ int main(int argc, char* argv[])
    }
    catch( Exception e )
    {
-     Logger::warning( "FATAL ERROR: %s", e.getDescription().c_str() );
+     Logger::error( "FATAL ERROR: %s", e.getDescription().c_str() );
    }
 
    return 0;
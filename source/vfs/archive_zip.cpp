@@ -17,6 +17,7 @@
 
 #include "filelist.hpp"
 #include "memfile.hpp"
+#include "filemapping.hpp"
 #include "core/logger.hpp"
 //#include <NrpLimitFile.h>
 
@@ -140,6 +141,13 @@ ZipArchiveReader::ZipArchiveReader( NFile file, bool ignoreCase, bool ignorePath
 			while (scanZipHeader()) { }
 
 		sort();
+
+    // archive from disk is mapped once, entries are read without copying
+    Mapping = FileMapping::open( file.getFileName() );
+    if( Mapping.isValid() && (long)Mapping->getSize() != file.getSize() )
+    {
+      Mapping = FileMappingPtr();
+    }
 	}
 }
 
@@ -531,17 +539,41 @@ NFile ZipArchiveReader::createAndOpenFile(unsigned int index)
 #endif
   }
 
+  if( decryptedSize == 0 )
+  {
+    return NFile();
+  }
+
+  // compressed data comes straight from mapped archive or decrypted buffer,
+  // uncompressed data is written into the buffer that memory file owns
+  ByteArray storage;
+  const char* pcData = decryptedBuf.empty()
+                          ? _getEntryData( e, decryptedSize, storage )
+                          : decryptedBuf.data();
+
+  const FilePath& entryName = _getItems()[ index ].fullName;
+
+  if( pcData == 0 )
+  {
+    Logger::warning( "Can't read data for %s", entryName.toString().c_str() );
+    return NFile();
+  }
+
   switch(actualCompressionMethod)
   {
     case 0: // no compression
     {
       if( decrypted.isOpen() )
-          return decrypted;
+      {
+        return decrypted;
+      }
+      else if( storage.empty() )
+      {
+        return MemoryFile::create( pcData, decryptedSize, entryName, SmartPtr< ReferenceCounted >( Mapping.object() ) );
+      }
       else
       {
-          File.seek( e.Offset );
-          ByteArray data = File.read( decryptedSize );
-          return MemoryFile::create( data, _getItems()[ index ].fullName );
+        return MemoryFile::create( storage, entryName );
       }
     }
     break;
@@ -549,31 +581,24 @@ NFile ZipArchiveReader::createAndOpenFile(unsigned int index)
     case 8:
     {
       const unsigned int uncompressedSize = e.header.DataDescriptor.UncompressedSize;
-      ByteArray pBuf;
-      pBuf.resize( uncompressedSize );
-
-      ByteArray pcData;
-      pcData.resize( decryptedSize );
-
-      if( pBuf.empty() || pcData.empty() )
+      if( uncompressedSize == 0 )
       {
-        Logger::warning( "Not enough memory for decompressing %s", _getItems()[ index ].fullName.toString().c_str() );
+        Logger::warning( "Not enough memory for decompressing %s", entryName.toString().c_str() );
         return NFile();
       }
 
-      File.seek(e.Offset);
-      pcData = File.read(decryptedSize);
+      char* pBuf = new char[ uncompressedSize ];
 
       // Setup the inflate stream.
       z_stream stream;
       int err;
 
-      stream.next_in = (Bytef*)pcData.data();
-                        stream.avail_in = (uInt)decryptedSize;
-      stream.next_out = (Bytef*)pBuf.data();
-			stream.avail_out = uncompressedSize;
-			stream.zalloc = (alloc_func)0;
-			stream.zfree = (free_func)0;
+      stream.next_in = (Bytef*)pcData;
+      stream.avail_in = (uInt)decryptedSize;
+      stream.next_out = (Bytef*)pBuf;
+      stream.avail_out = uncompressedSize;
+      stream.zalloc = (alloc_func)0;
+      stream.zfree = (free_func)0;
 
       // Perform inflation. wbits < 0 indicates no zlib header inside the data.
       err = inflateInit2(&stream, -MAX_WBITS);
@@ -582,20 +607,20 @@ NFile ZipArchiveReader::createAndOpenFile(unsigned int index)
         err = inflate(&stream, Z_FINISH);
         inflateEnd(&stream);
 
-	if (err == Z_STREAM_END)
-			err = Z_OK;
-	err = Z_OK;
-	inflateEnd(&stream);
+        if (err == Z_STREAM_END)
+          err = Z_OK;
+        err = Z_OK;
       }
 
       if (err != Z_OK)
       {
-        Logger::warning( "Error decompressing %s", _getItems()[index].fullName.toString().c_str() );
+        delete [] pBuf;
+        Logger::warning( "Error decompressing %s", entryName.toString().c_str() );
         return NFile();
       }
       else
       {
-        return MemoryFile::create( pBuf, _getItems()[index].fullName );
+        return MemoryFile::create( pBuf, uncompressedSize, entryName, true );
       }
     }
     break;
@@ -603,21 +628,12 @@ NFile ZipArchiveReader::createAndOpenFile(unsigned int index)
     case 12:
     {
       const unsigned int uncompressedSize = e.header.DataDescriptor.UncompressedSize;
-      ByteArray pBuf;
-      pBuf.resize( uncompressedSize );
-
-      ByteArray pcData;
-      pcData.resize( decryptedSize );
-
-      if( pBuf.empty() || pcData.empty() )
+      if( uncompressedSize == 0 )
       {
-        Logger::warning( "Not enough memory for decompressing %s", _getItems()[index].fullName.toString().c_str() );
+        Logger::warning( "Not enough memory for decompressing %s", entryName.toString().c_str() );
         return NFile();
       }
 
-      File.seek(e.Offset);
-      pcData = File.read(decryptedSize);
-
       bz_stream bz_ctx={0};
 			/* use BZIP2's default memory allocation
 			bz_ctx->bzalloc = NULL;
@@ -631,22 +647,25 @@ NFile ZipArchiveReader::createAndOpenFile(unsigned int index)
         return NFile();
       }
 
-      bz_ctx.next_in = (char*)pcData.data();
+      char* pBuf = new char[ uncompressedSize ];
+
+      bz_ctx.next_in = const_cast< char* >( pcData );
 			bz_ctx.avail_in = decryptedSize;
 			/* pass all input to decompressor */
-      bz_ctx.next_out = pBuf.data();
+      bz_ctx.next_out = pBuf;
 			bz_ctx.avail_out = uncompressedSize;
 			err = BZ2_bzDecompress(&bz_ctx);
 			err = BZ2_bzDecompressEnd(&bz_ctx);
 
       if (err != BZ_OK)
       {
-        Logger::warning( "Error decompressing %s", _getItems()[index].fullName.toString().c_str() );
+        delete [] pBuf;
+        Logger::warning( "Error decompressing %s", entryName.toString().c_str() );
         return NFile();
       }
       else
       {
-        return MemoryFile::create( pBuf, _getItems()[index].fullName );
+        return MemoryFile::create( pBuf, uncompressedSize, entryName, true );
       }
     }
     break;
@@ -654,39 +673,36 @@ NFile ZipArchiveReader::createAndOpenFile(unsigned int index)
     case 14:
     {
       unsigned int uncompressedSize = e.header.DataDescriptor.UncompressedSize;
-      ByteArray pBuf;
-      pBuf.resize( uncompressedSize );
-      ByteArray pcData;
-      pcData.resize( decryptedSize );
-      if( pBuf.empty() || pcData.empty() )
+      if( uncompressedSize == 0 || decryptedSize < 4 )
       {
-        Logger::warning( "Not enough memory for decompressing %s", _getItems()[index].fullName.toString().c_str() );
+        Logger::warning( "Not enough memory for decompressing %s", entryName.toString().c_str() );
         return NFile();
       }
 
-      File.seek(e.Offset);
-      pcData = File.read(decryptedSize);
+      char* pBuf = new char[ uncompressedSize ];
 
-                          ELzmaStatus status;
-                          SizeT tmpDstSize = uncompressedSize;
-                          SizeT tmpSrcSize = decryptedSize;
+      ELzmaStatus status;
+      SizeT tmpDstSize = uncompressedSize;
+      SizeT tmpSrcSize = decryptedSize;
 
-      unsigned int propSize = (pcData[3]<<8)+pcData[2];
-      int err = LzmaDecode((Byte*)pBuf.data(), &tmpDstSize,
-              (Byte*)pcData.data()+4+propSize, &tmpSrcSize,
-              (Byte*)pcData.data()+4, propSize,
+      const unsigned char* props = (const unsigned char*)pcData;
+      unsigned int propSize = (props[3]<<8)+props[2];
+      int err = LzmaDecode((Byte*)pBuf, &tmpDstSize,
+              (const Byte*)pcData+4+propSize, &tmpSrcSize,
+              (const Byte*)pcData+4, propSize,
                                           e.header.GeneralBitFlag&0x1?LZMA_FINISH_END:LZMA_FINISH_ANY, &status,
                                           &lzmaAlloc);
                           uncompressedSize = tmpDstSize; // may be different to expected value
 
       if (err != SZ_OK)
       {
-        Logger::warning( "Error decompressing %s", _getItems()[index].fullName.toString().c_str() );
+        delete [] pBuf;
+        Logger::warning( "Error decompressing %s", entryName.toString().c_str() );
         return NFile();
       }
       else
       {
-        return MemoryFile::create( pBuf, _getItems()[index].fullName );
+        return MemoryFile::create( pBuf, uncompressedSize, entryName, true );
       }
     }
     break;
@@ -709,6 +725,24 @@ NFile ZipArchiveReader::createAndOpenFile(unsigned int index)
   return NFile();
 }
 
+const char* ZipArchiveReader::_getEntryData( const SZipFileEntry& entry, unsigned int size, ByteArray& storage )
+{
+  if( Mapping.isValid() )
+  {
+    if( entry.Offset < 0 || entry.Offset + size > Mapping->getSize() )
+    {
+      return 0;
+    }
+
+    return Mapping->getData() + entry.Offset;
+  }
+
+  File.seek( entry.Offset );
+  storage = File.read( size );
+
+  return storage.size() == size ? storage.data() : 0;
+}
+
 std::string ZipArchiveReader::getTypeName() const
 {
     return "ZipReader";
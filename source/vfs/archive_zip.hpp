@@ -20,6 +20,7 @@
 #include "file.hpp"
 #include "archive.hpp"
 #include "filelist.hpp"
+#include "filemapping.hpp"
 
 namespace io
 {
@@ -223,8 +224,15 @@ protected:
 
   bool scanCentralDirectoryHeader();
 
+  //! returns pointer to size bytes of entry data, taken from mapped archive
+  //! or read to storage when archive isn't mapped
+  const char* _getEntryData( const SZipFileEntry& entry, unsigned int size, ByteArray& storage );
+
   NFile File;
 
+  // whole archive, null when archive can't be mapped
+  FileMappingPtr Mapping;
+
   // holds extended info about files
   std::vector< SZipFileEntry > FileInfo;
 
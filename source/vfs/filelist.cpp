@@ -175,34 +175,33 @@ unsigned int FileList::getFileOffset(unsigned int index) const
   return index < _d->files.size() ? _d->files[index].Offset : 0;
 }
 
-//! Searches for a file or folder within the list, returns the index
-int FileList::findFile(const FilePath& filename, bool isDirectory) const
+//! Returns filename in the form of list entries
+FilePath FileList::getEntryName( const FilePath& filename ) const
 {
-  FileListItem entry;
-  // we only need fullName to be set for the search
-  entry.fullName = StringHelper::replace( filename.toString(), "\\", "/" );
-  entry.isDirectory = isDirectory;
-
-  // remove trailing slash
-  if( *entry.fullName.toString().rbegin() == '/' )
-  {
-    entry.isDirectory = true;
-  }
-  entry.fullName = entry.fullName.removeEndSlash();
+  FilePath ret = StringHelper::replace( filename.toString(), "\\", "/" );
+  ret = ret.removeEndSlash();
 
   if( _d->ignoreCase )
   {
-    entry.fullName = StringHelper::localeLower( entry.fullName.toString() );
+    ret = StringHelper::localeLower( ret.toString() );
   }
 
   if( _d->ignorePaths )
   {
-    entry.fullName = entry.fullName.getBasename();
+    ret = ret.getBasename();
   }
 
+  return ret;
+}
+
+//! Searches for a file or folder within the list, returns the index
+int FileList::findFile(const FilePath& filename, bool isDirectory) const
+{
+  FilePath fullName = getEntryName( filename );
+
   for( Items::iterator it=_d->files.begin(); it != _d->files.end(); it++ )
   {
-    if( (*it).fullName == entry.fullName )
+    if( (*it).fullName == fullName )
     {
       return std::distance( _d->files.begin(), it );
     }
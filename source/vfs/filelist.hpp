@@ -83,6 +83,9 @@ public:
   //! Searches for a file or folder within the list, returns the index
   int findFile(const FilePath& filename, bool isFolder=false) const;
 
+  //! Returns filename in the form of list entries, as findFile compares it
+  FilePath getEntryName( const FilePath& filename ) const;
+
   //! Returns the base path of the file list
   const FilePath& getPath() const;
 
@@ -0,0 +1,131 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "filemapping.hpp"
+#include "core/platform.hpp"
+#include "core/logger.hpp"
+
+#if defined(OC3_PLATFORM_WIN)
+  #include <windows.h>
+#elif defined(OC3_PLATFORM_UNIX)
+  #include <sys/types.h>
+  #include <sys/stat.h>
+  #include <sys/mman.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace io
+{
+
+class FileMapping::Impl
+{
+public:
+  const char* data;
+  unsigned int size;
+
+#if defined(OC3_PLATFORM_WIN)
+  HANDLE file;
+  HANDLE mapping;
+#endif
+};
+
+FileMapping::FileMapping() : _d( new Impl )
+{
+  _d->data = 0;
+  _d->size = 0;
+
+#if defined(OC3_PLATFORM_WIN)
+  _d->file = INVALID_HANDLE_VALUE;
+  _d->mapping = 0;
+#endif
+}
+
+FileMappingPtr FileMapping::open( const FilePath& filename )
+{
+  FileMappingPtr ret( new FileMapping() );
+  ret->drop();
+
+  Impl& d = *ret->_d;
+
+#if defined(OC3_PLATFORM_WIN)
+  d.file = ::CreateFileA( filename.toString().c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+                          OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0 );
+  if( d.file == INVALID_HANDLE_VALUE )
+  {
+    return FileMappingPtr();
+  }
+
+  d.size = ::GetFileSize( d.file, 0 );
+  d.mapping = ::CreateFileMappingA( d.file, 0, PAGE_READONLY, 0, 0, 0 );
+  if( d.size == 0 || d.mapping == 0 )
+  {
+    return FileMappingPtr();
+  }
+
+  d.data = (const char*)::MapViewOfFile( d.mapping, FILE_MAP_READ, 0, 0, 0 );
+#elif defined(OC3_PLATFORM_UNIX)
+  int fd = ::open( filename.toString().c_str(), O_RDONLY );
+  if( fd < 0 )
+  {
+    return FileMappingPtr();
+  }
+
+  struct stat info;
+  if( ::fstat( fd, &info ) != 0 || info.st_size <= 0 )
+  {
+    ::close( fd );
+    return FileMappingPtr();
+  }
+
+  d.size = (unsigned int)info.st_size;
+  void* memory = ::mmap( 0, d.size, PROT_READ, MAP_PRIVATE, fd, 0 );
+  // the mapping keeps file alive, descriptor is not needed anymore
+  ::close( fd );
+
+  d.data = (memory != MAP_FAILED) ? (const char*)memory : 0;
+#endif
+
+  if( d.data == 0 )
+  {
+    Logger::warning( "Can't map file %s", filename.toString().c_str() );
+    return FileMappingPtr();
+  }
+
+  return ret;
+}
+
+FileMapping::~FileMapping()
+{
+#if defined(OC3_PLATFORM_WIN)
+  if( _d->data ) { ::UnmapViewOfFile( _d->data ); }
+  if( _d->mapping ) { ::CloseHandle( _d->mapping ); }
+  if( _d->file != INVALID_HANDLE_VALUE ) { ::CloseHandle( _d->file ); }
+#elif defined(OC3_PLATFORM_UNIX)
+  if( _d->data ) { ::munmap( (void*)_d->data, _d->size ); }
+#endif
+}
+
+const char* FileMapping::getData() const
+{
+  return _d->data;
+}
+
+unsigned int FileMapping::getSize() const
+{
+  return _d->size;
+}
+
+} //end namespace io
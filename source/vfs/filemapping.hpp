@@ -0,0 +1,53 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __OPENCAESAR3_FILEMAPPING_H_INCLUDED__
+#define __OPENCAESAR3_FILEMAPPING_H_INCLUDED__
+
+#include "core/referencecounted.hpp"
+#include "core/smartptr.hpp"
+#include "core/scopedptr.hpp"
+#include "filepath.hpp"
+
+namespace io
+{
+
+class FileMapping;
+typedef SmartPtr< FileMapping > FileMappingPtr;
+
+//! Read-only memory mapping of a whole native file.
+/** Memory files created over the mapping keep a reference to it,
+so the view stays valid until the last of them is dropped. */
+class FileMapping : public ReferenceCounted
+{
+public:
+  //! maps file, returns null pointer when file can't be mapped
+  static FileMappingPtr open( const FilePath& filename );
+
+  virtual ~FileMapping();
+
+  const char* getData() const;
+  unsigned int getSize() const;
+
+private:
+  FileMapping();
+
+  class Impl;
+  ScopedPtr< Impl > _d;
+};
+
+} //end namespace io
+
+#endif //__OPENCAESAR3_FILEMAPPING_H_INCLUDED__
@@ -20,6 +20,8 @@
 #include "filelist.hpp"
 #include "archive_zip.hpp"
 #include "core/logger.hpp"
+#include "core/stringhelper.hpp"
+#include <map>
 
 #if defined (OC3_PLATFORM_WIN)
 	#include <direct.h> // for _chdir
@@ -53,9 +55,74 @@ public:
 
   Mode fileSystemType;
 
+  //! entries of all mounted archives by hash of lowercase file name,
+  //! every bucket keeps archives order, so first match has mount priority
+  struct IndexEntry
+  {
+    std::string name;
+    ArchivePtr archive;
+    unsigned int index;
+  };
+
+  typedef std::vector< IndexEntry > IndexBucket;
+  typedef std::map< unsigned int, IndexBucket > Index;
+  Index index;
+
   ArchivePtr changeArchivePassword( const FilePath& filename, const std::string& password );
+  static unsigned int getIndexKey( const FilePath& filename );
+  void updateIndex();
+  const IndexEntry* findEntry( const FilePath& filename ) const;
 };
 
+unsigned int FileSystem::Impl::getIndexKey( const FilePath& filename )
+{
+  // archives may differ in ignoreCase and ignorePaths flags,
+  // so key uses the most relaxed form and entries are checked by archive itself
+  FilePath name = StringHelper::replace( filename.toString(), "\\", "/" );
+  name = name.removeEndSlash().getBasename();
+
+  return StringHelper::hash( StringHelper::localeLower( name.toString() ) );
+}
+
+void FileSystem::Impl::updateIndex()
+{
+  index.clear();
+
+  for( unsigned int i=0; i < openArchives.size(); ++i )
+  {
+    const FileList* list = openArchives[i]->getFileList();
+    for( unsigned int k=0; k < list->getFileCount(); ++k )
+    {
+      IndexEntry entry;
+      entry.name = list->getFullFileName( k ).toString();
+      entry.archive = openArchives[i];
+      entry.index = k;
+
+      index[ getIndexKey( entry.name ) ].push_back( entry );
+    }
+  }
+}
+
+const FileSystem::Impl::IndexEntry* FileSystem::Impl::findEntry( const FilePath& filename ) const
+{
+  Index::const_iterator it = index.find( getIndexKey( filename ) );
+  if( it == index.end() )
+  {
+    return 0;
+  }
+
+  const IndexBucket& bucket = it->second;
+  for( IndexBucket::const_iterator entry=bucket.begin(); entry != bucket.end(); entry++ )
+  {
+    if( entry->archive->getFileList()->getEntryName( filename ).toString() == entry->name )
+    {
+      return &(*entry);
+    }
+  }
+
+  return 0;
+}
+
 ArchivePtr FileSystem::Impl::changeArchivePassword(const FilePath& filename, const std::string& password )
 {
   for (int idx = 0; idx < (int)openArchives.size(); ++idx)
@@ -97,13 +164,10 @@ FileSystem::~FileSystem()
 
 NFile FileSystem::loadFileFromArchive( const FilePath& filePath )
 {
-  for( unsigned int i=0; i< _d->openArchives.size(); ++i)
+  const Impl::IndexEntry* entry = _d->findEntry( filePath );
+  if( entry )
   {
-    NFile file = _d->openArchives[i]->createAndOpenFile( filePath );
-    if( file.isOpen() )
-    {
-      return file;
-    }
+    return entry->archive->createAndOpenFile( entry->index );
   }
 
   return NFile();
@@ -171,6 +235,11 @@ bool FileSystem::moveFileArchive(unsigned int sourceIndex, int relative)
 		r = true;
 	}
 
+	if( r )
+	{
+		_d->updateIndex();
+	}
+
 	return r;
 }
 
@@ -272,6 +341,7 @@ ArchivePtr FileSystem::mountArchive(  const FilePath& filename,
   if( archive.isValid() )
   {
     _d->openArchives.push_back( archive );
+    _d->updateIndex();
     if( password.size() )
     {
         archive->Password=password;
@@ -367,6 +437,7 @@ ArchivePtr FileSystem::mountArchive(NFile file, Archive::Type archiveType,
     {
       Logger::warning( "Mount archive %s", file.getFileName().toString().c_str() );
       _d->openArchives.push_back(archive);
+      _d->updateIndex();
 
       if (password.size())
       {
@@ -397,6 +468,7 @@ ArchivePtr FileSystem::mountArchive( ArchivePtr archive)
 	}
 
 	_d->openArchives.push_back(archive);
+	_d->updateIndex();
     return archive;
 }
 
@@ -409,6 +481,7 @@ bool FileSystem::unmountArchive(unsigned int index)
 	{
 		_d->openArchives[index]->drop();
 		_d->openArchives.erase( _d->openArchives.begin() + index );
+		_d->updateIndex();
 		ret = true;
 	}
 
@@ -672,9 +745,8 @@ FileList FileSystem::getFileList()
 //! determines if a file exists and would be able to be opened.
 bool FileSystem::existFile(const FilePath& filename) const
 {
-  for (unsigned int i=0; i < _d->openArchives.size(); ++i)
-      if (_d->openArchives[i]->getFileList()->findFile(filename)!=-1)
-              return true;
+  if( _d->findEntry( filename ) )
+    return true;
 
 #if defined(OC3_PLATFORM_WIN)
   return ( _access( filename.toString().c_str(), 0) != -1);
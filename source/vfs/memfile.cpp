@@ -26,6 +26,7 @@ MemoryFile::MemoryFile()
     Len = 0;
     Pos = 0;
     deleteMemoryWhenDropped = false;
+    readOnly = false;
 
 #ifdef _DEBUG
         setDebugName(L"MemoryFile");
@@ -64,6 +65,22 @@ NFile MemoryFile::create( ByteArray data, const FilePath& fileName )
     return NFile( ret );
 }
 
+NFile MemoryFile::create( const void* memory, long len, const FilePath& fileName, SmartPtr< ReferenceCounted > owner )
+{
+    MemoryFile* mf = new MemoryFile();
+    mf->Buffer = const_cast< void* >( memory );
+    mf->Len  = len;
+    mf->Pos = 0;
+    mf->Filename = fileName;
+    mf->readOnly = true;
+    mf->owner = owner;
+
+    FSEntityPtr ret( mf );
+    ret->drop();
+
+    return NFile( ret );
+}
+
 MemoryFile::~MemoryFile()
 {
 	if (deleteMemoryWhenDropped)
@@ -138,6 +155,9 @@ ByteArray MemoryFile::readLine()
 //! returns how much was written
 int MemoryFile::write(const void* buffer, unsigned int sizeToWrite)
 {
+    if( readOnly )
+        return 0;
+
     int amount = static_cast<int>(sizeToWrite);
 	if (Pos + amount > Len)
 		amount -= Pos + amount - Len;
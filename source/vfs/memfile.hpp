@@ -20,6 +20,7 @@
 #include "file.hpp"
 #include "filepath.hpp"
 #include "core/bytearray.hpp"
+#include "core/referencecounted.hpp"
 
 namespace io
 {
@@ -66,6 +67,10 @@ public:
   static NFile create( void* memory, long len, const FilePath& fileName, bool deleteMemoryWhenDropped );
   static NFile create( ByteArray data, const FilePath& fileName );
 
+  //! read-only view of memory owned by other object, file grabs owner
+  //! while alive, so the memory is not copied
+  static NFile create( const void* memory, long len, const FilePath& fileName, SmartPtr< ReferenceCounted > owner );
+
 private:
   MemoryFile();
 
@@ -74,6 +79,8 @@ private:
   long Pos;
   FilePath Filename;
   bool deleteMemoryWhenDropped;
+  bool readOnly;
+  SmartPtr< ReferenceCounted > owner;
 };
 
 } //end namespace io
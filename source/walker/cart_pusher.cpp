@@ -37,12 +37,15 @@
 #include "building/constants.hpp"
 #include "corpse.hpp"
 #include "game/resourcegroup.hpp"
+#include "core/mempool.hpp"
 
 using namespace constants;
 
 class CartPusher::Impl
 {
 public:
+  OC3_POOLED_ALLOCATION
+
   GoodStock stock;
   BuildingPtr producerBuilding;
   BuildingPtr consumerBuilding;
@@ -60,6 +63,7 @@ CartPusher::CartPusher( CityPtr city )
 {
   _setAnimation( gfx::cartPusher );
   _setType( walker::cartPusher );
+  _setBatchWalk( false );  // may change destination before walking
   _d->producerBuilding = NULL;
   _d->consumerBuilding = NULL;
   _d->maxDistance = 25;
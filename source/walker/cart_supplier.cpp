@@ -31,12 +31,15 @@
 #include "game/goodstore.hpp"
 #include "building/constants.hpp"
 #include "core/direction.hpp"
+#include "core/mempool.hpp"
 
 using namespace constants;
 
 class CartSupplier::Impl
 {
 public:
+  OC3_POOLED_ALLOCATION
+
   CityPtr city;
   GoodStock stock;
   TilePos storageBuildingPos;
@@ -75,6 +75,7 @@ Corpse::Corpse( CityPtr city ) : Walker( city ), _d( new Impl )
 {
   _setType( walker::corpse );
   _setAnimation( gfx::unknown );
+  _setBatchWalk( false );  // never walks
 
   _d->startIndex = 0;
   _d->currentIndex = 0;
@@ -21,18 +21,23 @@
 #include "gfx/tile.hpp"
 #include "core/variant.hpp"
 #include "game/city.hpp"
+#include "game/cityservice_vacancies.hpp"
 #include "game/path_finding.hpp"
 #include "game/tilemap.hpp"
 #include "game/name_generator.hpp"
 #include "building/constants.hpp"
 #include "game/resourcegroup.hpp"
 #include "corpse.hpp"
+#include "core/mempool.hpp"
+#include "core/random.hpp"
 
 using namespace constants;
 
 class Immigrant::Impl
 {
 public:
+  OC3_POOLED_ALLOCATION
+
   TilePos destination;
   Picture cartPicture;
   CitizenGroup peoples;
@@ -46,53 +51,39 @@ Immigrant::Immigrant( CityPtr city )
   _setAnimation( gfx::homeless );
 
   setName( NameGenerator::rand( NameGenerator::male ) );
-  _d->stamina = rand() % 80 + 20;
+  _d->stamina = city->getRandom().get() % 80 + 20;
 }
 
-HousePtr Immigrant::_findBlankHouse()
+void Immigrant::_findPath2blankHouse( Tile& startPoint )
 {
-  CityHelper hlp( _getCity() );
-  HouseList houses = hlp.find< House >( building::house );
-  HousePtr blankHouse;
+  Pathway pathWay;
+  HousePtr house;
   _d->destination = TilePos( -1, -1 );
 
-  HouseList::iterator itHouse = houses.begin();
-  while( itHouse != houses.end() )
+  SmartPtr< CityServiceVacancies > vacancies;
+  vacancies = _getCity()->findService( CityServiceVacancies::getDefaultName() ).as<CityServiceVacancies>();
+  if( vacancies.isValid() )
   {
-    if( (*itHouse)->getAccessRoads().size() > 0 && 
-        ( (*itHouse)->getHabitants().count() < (*itHouse)->getMaxHabitants() ) )
-    {
-      itHouse++;
-    }
-    else
-    {
-      itHouse = houses.erase( itHouse );
-    }
+    house = vacancies->findHouse( startPoint.getIJ(), pathWay );
   }
 
-  if( houses.size() > 0 )
+  if( house.isValid() )
   {
-    itHouse = houses.begin();
-    std::advance(itHouse, rand() % houses.size() );
-    blankHouse = *itHouse;
-    _d->destination = blankHouse->getTilePos();
+    _d->destination = house->getTilePos();
   }
 
-  return blankHouse;
-}
-
-void Immigrant::_findPath2blankHouse( Tile& startPoint )
-{
-  HousePtr house = _findBlankHouse();
-
-  Pathway pathWay;
+  // way is ready when we start on road network of the entry, otherwise search it
+  bool pathFound = pathWay.isValid();
+  if( !pathFound )
+  {
+    Tilemap& citymap = _getCity()->getTilemap();
+    Tile& destTile = house.isValid() ? house->getTile() : citymap.at( _getCity()->getBorderInfo().roadExit );
+    Size arrivedArea( house.isValid() ? house->getSize() : 1 );
 
-  Tilemap& citymap = _getCity()->getTilemap();
-  Tile& destTile = house.isValid() ? house->getTile() : citymap.at( _getCity()->getBorderInfo().roadExit );
-  Size arrivedArea( house.isValid() ? house->getSize() : 1 );
+    pathFound = Pathfinder::getInstance().getPath( startPoint.getIJ(), destTile.getIJ(), pathWay,
+                                                   false, arrivedArea );
+  }
 
-  bool pathFound = Pathfinder::getInstance().getPath( startPoint.getIJ(), destTile.getIJ(), pathWay, 
-                                                      false, arrivedArea );
   if( pathFound )
   {
      setPathway( pathWay );
@@ -44,7 +44,6 @@ protected:
   
   Immigrant( CityPtr city );
 
-  HousePtr _findBlankHouse();
   void _findPath2blankHouse( Tile& startPoint );
 
 protected:
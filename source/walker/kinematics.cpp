@@ -0,0 +1,172 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "kinematics.hpp"
+#include "game/tilemap.hpp"
+#include "gfx/tile.hpp"
+#include "gfx/tileoverlay.hpp"
+
+using namespace constants;
+
+const int WalkerKinematics::axisI[ countDirection ] = { 0, 0, -1, -1, -1, 0, 1, 1, 1 };
+const int WalkerKinematics::axisJ[ countDirection ] = { 0, 1, 1, 0, -1, -1, -1, 0, 1 };
+
+namespace {
+
+// true if walker moving along axis reaches tile center or tile border
+inline bool isCrossing( const int step, const int si, const int amount, const int midPos )
+{
+  if( step > 0 )
+  {
+    return (si < midPos && si + amount >= midPos) || si + amount > 15;
+  }
+
+  if( step < 0 )
+  {
+    return (si > midPos && si - amount <= midPos) || si - amount < 0;
+  }
+
+  return false;
+}
+
+}
+
+WalkerKinematicsPtr WalkerKinematics::create()
+{
+  WalkerKinematicsPtr ret( new WalkerKinematics() );
+  ret->drop();
+
+  return ret;
+}
+
+WalkerKinematics::WalkerKinematics()
+{
+}
+
+WalkerKinematics::Slot WalkerKinematics::alloc()
+{
+  Slot slot;
+  if( !_freeSlots.empty() )
+  {
+    slot = _freeSlots.back();
+    _freeSlots.pop_back();
+  }
+  else
+  {
+    slot = flags.size();
+    tileI.push_back( 0 );      tileJ.push_back( 0 );
+    offsetX.push_back( 0 );    offsetY.push_back( 0 );
+    midX.push_back( 0 );       midY.push_back( 0 );
+    mapX.push_back( 0 );       mapY.push_back( 0 );
+    remainX.push_back( 0.f );  remainY.push_back( 0.f );
+    speed.push_back( 0.f );    speedMultiplier.push_back( 0.f );
+    direction.push_back( noneDirection );
+    flags.push_back( 0 );
+    _nextOffsetX.push_back( 0 ); _nextOffsetY.push_back( 0 );
+    _nextRemainX.push_back( 0.f ); _nextRemainY.push_back( 0.f );
+  }
+
+  tileI[ slot ] = tileJ[ slot ] = 0;
+  offsetX[ slot ] = offsetY[ slot ] = 0;
+  midX[ slot ] = midY[ slot ] = 7;
+  mapX[ slot ] = mapY[ slot ] = 0;
+  remainX[ slot ] = remainY[ slot ] = 0.f;
+  speed[ slot ] = speedMultiplier[ slot ] = 1.f;
+  direction[ slot ] = noneDirection;
+  flags[ slot ] = batch;
+
+  return slot;
+}
+
+void WalkerKinematics::free( Slot slot )
+{
+  flags[ slot ] = 0;
+  _freeSlots.push_back( slot );
+}
+
+void WalkerKinematics::setFlag( Slot slot, Flag flag, bool value )
+{
+  flags[ slot ] = value ? (flags[ slot ] | flag) : (flags[ slot ] & ~flag);
+}
+
+void WalkerKinematics::think( Slot begin, Slot end )
+{
+  // same arithmetic as Walker::walk() for walkers which stay inside their tile
+  for( Slot k=begin; k < end; k++ )
+  {
+    const unsigned char f = flags[ k ] & ~advanced;
+    flags[ k ] = f;
+
+    const int dir = direction[ k ];
+    if( (f & (moving|batch|deleted)) != (moving|batch)
+        || dir == noneDirection || dir < 0 || dir >= countDirection )
+    {
+      continue;
+    }
+
+    const int stepI = axisI[ dir ];
+    const int stepJ = axisJ[ dir ];
+    const float delta = speedMultiplier[ k ] * speed[ k ] * ( (stepI != 0 && stepJ != 0) ? 0.7f : 1.f );
+    const float moveI = remainX[ k ] + ( stepI != 0 ? delta : 0.f );
+    const float moveJ = remainY[ k ] + ( stepJ != 0 ? delta : 0.f );
+    const int amountI = int( moveI );
+    const int amountJ = int( moveJ );
+
+    if( isCrossing( stepI, offsetX[ k ], amountI, midX[ k ] )
+        || isCrossing( stepJ, offsetY[ k ], amountJ, midY[ k ] ) )
+    {
+      // Walker::walk() will do this step with callbacks
+      continue;
+    }
+
+    _nextRemainX[ k ] = moveI - float( amountI );
+    _nextRemainY[ k ] = moveJ - float( amountJ );
+    _nextOffsetX[ k ] = offsetX[ k ] + stepI * amountI;
+    _nextOffsetY[ k ] = offsetY[ k ] + stepJ * amountJ;
+    flags[ k ] = f | advanced;
+  }
+}
+
+void WalkerKinematics::commit( const Tilemap& tilemap )
+{
+  const Slot count = flags.size();
+  for( Slot k=0; k < count; k++ )
+  {
+    if( (flags[ k ] & advanced) == 0 )
+    {
+      continue;
+    }
+
+    remainX[ k ] = _nextRemainX[ k ];
+    remainY[ k ] = _nextRemainY[ k ];
+    offsetX[ k ] = _nextOffsetX[ k ];
+    offsetY[ k ] = _nextOffsetY[ k ];
+
+    // walker did not leave its tile, so overlay under it is still the start one,
+    // overlay is taken here because reference counter of it is not thread safe
+    int overlayX = 0;
+    int overlayY = 0;
+    TileOverlayPtr overlay = tilemap.at( tileI[ k ], tileJ[ k ] ).getOverlay();
+    if( overlay.isValid() )
+    {
+      Point offset = overlay->getOffset( Point( offsetX[ k ], offsetY[ k ] ) );
+      overlayX = offset.getX();
+      overlayY = offset.getY();
+    }
+
+    mapX[ k ] = tileI[ k ] * 15 + offsetX[ k ] + overlayX;
+    mapY[ k ] = tileJ[ k ] * 15 + offsetY[ k ] + overlayY;
+  }
+}
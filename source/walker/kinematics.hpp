@@ -0,0 +1,80 @@
+// This file is part of openCaesar3.
+//
+// openCaesar3 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// openCaesar3 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with openCaesar3.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __OPENCAESAR3_WALKER_KINEMATICS_H_INCLUDED__
+#define __OPENCAESAR3_WALKER_KINEMATICS_H_INCLUDED__
+
+#include "core/referencecounted.hpp"
+#include "core/predefinitions.hpp"
+#include "core/direction.hpp"
+
+#include <vector>
+
+class Tilemap;
+
+// Movement state of all walkers of a city, one array per field and one slot
+// per walker. Walker keeps its position and movement only here, so city can
+// advance every walker which stays inside its tile in one tight loop. Walkers
+// which reach tile border or tile center this step are left to Walker::walk(),
+// because only they need onNewTile()/onMidTile() callbacks.
+// Step is split in think(), which writes only move intents of its own slots
+// and may run on several threads, and commit(), which applies them in order.
+class WalkerKinematics : public ReferenceCounted
+{
+public:
+  typedef unsigned int Slot;
+  typedef enum { moving=0x1, batch=0x2, deleted=0x4, advanced=0x8 } Flag;
+
+  // subtile movement along i/j axis for every direction: 1 - increase, -1 - decrease
+  static const int axisI[ constants::countDirection ];
+  static const int axisJ[ constants::countDirection ];
+
+  static WalkerKinematicsPtr create();
+
+  Slot alloc();
+  void free( Slot slot );
+
+  Slot getSlotsCount() const { return flags.size(); }
+
+  // computes move intents of walkers with moving and batch flags set and marks
+  // them as advanced, reads and writes nothing outside slots [begin, end)
+  void think( Slot begin, Slot end );
+
+  // moves advanced walkers to their intents, places them on map
+  void commit( const Tilemap& tilemap );
+
+  bool isAdvanced( Slot slot ) const { return (flags[ slot ] & advanced) != 0; }
+  void setFlag( Slot slot, Flag flag, bool value );
+
+  std::vector< int > tileI, tileJ;         // tile coordinate
+  std::vector< int > offsetX, offsetY;     // subtile coordinate in the current tile: 0..15
+  std::vector< int > midX, midY;           // subtile coordinate of the tile center
+  std::vector< int > mapX, mapY;           // subtile coordinate across all tiles: 15*i+si
+  std::vector< float > remainX, remainY;   // remaining movement
+  std::vector< float > speed, speedMultiplier;
+  std::vector< int > direction;
+  std::vector< unsigned char > flags;
+
+private:
+  WalkerKinematics();
+
+  // move intents, valid for advanced slots only
+  std::vector< int > _nextOffsetX, _nextOffsetY;
+  std::vector< float > _nextRemainX, _nextRemainY;
+
+  std::vector< Slot > _freeSlots;
+};
+
+#endif //__OPENCAESAR3_WALKER_KINEMATICS_H_INCLUDED__
@@ -23,12 +23,15 @@
 #include "game/name_generator.hpp"
 #include "constants.hpp"
 #include "corpse.hpp"
+#include "core/mempool.hpp"
 
 using namespace constants;
 
 class MarketKid::Impl
 {
 public:
+  OC3_POOLED_ALLOCATION
+
   GoodStock basket;
   unsigned long delay;
   TilePos marketPos;
@@ -55,6 +58,7 @@ MarketKid::MarketKid( CityPtr city )
   _d->basket._maxQty = 100;
   _setAnimation( gfx::marketkid );
   _setType( walker::marketKid );
+  _setBatchWalk( false );  // waits for delay before walking
 
   setName( NameGenerator::rand( NameGenerator::male ) );
 }
@@ -30,12 +30,15 @@
 #include "game/city.hpp"
 #include "game/name_generator.hpp"
 #include "building/constants.hpp"
+#include "core/mempool.hpp"
 
 using namespace constants;
 
 class MarketLady::Impl
 {
 public:
+  OC3_POOLED_ALLOCATION
+
   TilePos destBuildingPos;  // granary or warehouse
   Good::Type priorityGood;
   int maxDistance;
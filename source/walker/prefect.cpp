@@ -31,9 +31,14 @@
 #include "game/resourcegroup.hpp"
 #include "protestor.hpp"
 #include "game/pathway_helper.hpp"
+#include "game/cityservice_firerisk.hpp"
 
 using namespace constants;
 
+namespace {
+  static const double fireRiskLevel = 50;  // patrol goes to buildings which reached it
+}
+
 class Prefect::Impl
 {
 public:
@@ -99,6 +104,39 @@ bool Prefect::_looks4Protestor( TilePos& pos )
   return !protestors.empty();
 }
 
+bool Prefect::_findFireRiskWay( PrefecturePtr prefecture, Pathway& way )
+{
+  SmartPtr< CityServiceFireRisk > fireRisk = _getCity()->findService( CityServiceFireRisk::getDefaultName() ).as<CityServiceFireRisk>();
+  if( fireRisk.isNull() || prefecture->getAccessRoads().empty() )
+    return false;
+
+  TilePos start = prefecture->getAccessRoads().front()->getIJ();
+
+  // riskiest building in reach of prefecture, which no other prefect goes to
+  ConstructionList risks = fireRisk->find( fireRiskLevel );
+  foreach( ConstructionPtr construction, risks )
+  {
+    BuildingPtr building = construction.as<Building>();
+    if( building.isNull() || building->getTilePos().distanceFrom( start ) > getMaxDistance() )
+      continue;
+
+    if( building->evaluateService( ServiceWalkerPtr( this ) ) <= 0 )
+      continue;
+
+    // building is unreachable or too far by road, try next one
+    Pathway tmp;
+    bool foundPath = Pathfinder::getInstance().getPath( start, building->getEnterPos(), tmp,
+                                                        false, Size( 0 ) );
+    if( !foundPath || tmp.getLength() > getMaxDistance() )
+      continue;
+
+    way = tmp;
+    return true;
+  }
+
+  return false;
+}
+
 void Prefect::_checkPath2NearestFire( const ReachedBuildings& buildings )
 {
   Pathway bestPath;
@@ -395,7 +433,20 @@ void Prefect::send2City(PrefecturePtr prefecture, int water/*=0 */ )
   }
   else
   {
-    ServiceWalker::send2City( prefecture.as<Building>() );
+    Pathway way;
+    if( _findFireRiskWay( prefecture, way ) )
+    {
+      setBase( prefecture.as<Building>() );
+      reservePath( way );
+      setPathway( way );
+      setIJ( way.getOrigin().getIJ() );
+
+      _getCity()->addWalker( WalkerPtr( this ) );
+    }
+    else
+    {
+      ServiceWalker::send2City( prefecture.as<Building>() );
+    }
 
     _d->endPatrolPoint = _getPathway().getDestination().getIJ();
   }
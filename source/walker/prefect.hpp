@@ -43,6 +43,7 @@ protected:
 
   bool _looks4Protestor(TilePos& pos);
   bool _looks4Fire( ReachedBuildings& buildings, TilePos& pos );
+  bool _findFireRiskWay( PrefecturePtr prefecture, Pathway& way );
   void _checkPath2NearestFire( const ReachedBuildings& buildings );
   void _serveBuildings( ReachedBuildings& reachedBuildings );
   void _back2Prefecture();
@@ -29,6 +29,7 @@
 #include "ability.hpp"
 #include "game/resourcegroup.hpp"
 #include "core/variant.hpp"
+#include "core/random.hpp"
 
 using namespace constants;
 
@@ -255,7 +256,7 @@ Pathway Protestor::Impl::findTarget( CityPtr city, ConstructionList construction
     for( int i=0; i<10; i++)
     {
       ConstructionList::iterator it = constructions.begin();
-      std::advance( it, rand() % constructions.size() );
+      std::advance( it, city->getRandom().get() % constructions.size() );
 
       pathway = PathwayHelper::create( city, pos, (*it)->getEnterPos(), PathwayHelper::allTerrain );
       if( pathway.isValid() )
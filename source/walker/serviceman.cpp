@@ -25,12 +25,15 @@
 #include "constants.hpp"
 #include "game/resourcegroup.hpp"
 #include "corpse.hpp"
+#include "core/mempool.hpp"
 
 using namespace constants;
 
 class ServiceWalker::Impl
 {
 public:
+  OC3_POOLED_ALLOCATION
+
   BuildingPtr base;
   Service::Type service;
   int maxDistance;
@@ -354,6 +357,11 @@ void ServiceWalker::setMaxDistance( const int distance )
   _d->maxDistance = distance;
 }
 
+int ServiceWalker::getMaxDistance() const
+{
+  return _d->maxDistance;
+}
+
 float ServiceWalker::getServiceValue() const
 {
   return 100;
@@ -46,6 +46,7 @@ public:
 
   virtual void return2Base();
   void setMaxDistance( const int distance );
+  int getMaxDistance() const;
 
   virtual void save( VariantMap& stream) const;
   virtual void load( const VariantMap& stream);
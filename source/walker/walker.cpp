@@ -31,61 +31,145 @@
 #include "game/tilemap.hpp"
 #include "core/logger.hpp"
 #include "ability.hpp"
+#include "core/mempool.hpp"
+#include "kinematics.hpp"
 
 using namespace constants;
 
 class Walker::Impl
 {
 public:
+  OC3_POOLED_ALLOCATION
+
   CityPtr city;
   walker::Type walkerType;
   gfx::Type walkerGraphic;
   bool isDeleted;
-  float speed;
-  TilePos pos;
   UniqueId uid;
-  Point midTilePos;  // subtile coordinate in the current tile, at starting position
-  float speedMultiplier;
-  Point tileOffset; // subtile coordinate in the current tile: 0..15
   Animation animation;  // current animation
-  Point posOnMap; // subtile coordinate across all tiles: 0..15*mapsize (ii=15*i+si)
-  PointF remainMove;  // remaining movement
   Pathway pathWay;
   DirectedAction action;
   std::string name;
   int health;
   AbilityList abilities;
+  const Tile* tile;  // cached tile at pos
+
+  // position and movement are kept by city, see WalkerKinematics
+  WalkerKinematicsPtr kinematics;
+  WalkerKinematics::Slot slot;
+
+  TilePos getPos() const
+  {
+    return TilePos( kinematics->tileI[ slot ], kinematics->tileJ[ slot ] );
+  }
+
+  void setPos( const TilePos& pos )
+  {
+    kinematics->tileI[ slot ] = pos.getI();
+    kinematics->tileJ[ slot ] = pos.getJ();
+  }
+
+  // subtile coordinate in the current tile: 0..15
+  Point getTileOffset() const
+  {
+    return Point( kinematics->offsetX[ slot ], kinematics->offsetY[ slot ] );
+  }
+
+  void setTileOffset( const Point& offset )
+  {
+    kinematics->offsetX[ slot ] = offset.getX();
+    kinematics->offsetY[ slot ] = offset.getY();
+  }
+
+  // subtile coordinate in the current tile, at starting position
+  Point getMidTilePos() const
+  {
+    return Point( kinematics->midX[ slot ], kinematics->midY[ slot ] );
+  }
+
+  void setMidTilePos( const Point& pos )
+  {
+    kinematics->midX[ slot ] = pos.getX();
+    kinematics->midY[ slot ] = pos.getY();
+  }
+
+  // subtile coordinate across all tiles: 0..15*mapsize (ii=15*i+si)
+  Point getPosOnMap() const
+  {
+    return Point( kinematics->mapX[ slot ], kinematics->mapY[ slot ] );
+  }
+
+  void setPosOnMap( const Point& pos )
+  {
+    kinematics->mapX[ slot ] = pos.getX();
+    kinematics->mapY[ slot ] = pos.getY();
+  }
+
+  PointF getRemainMove() const
+  {
+    return PointF( kinematics->remainX[ slot ], kinematics->remainY[ slot ] );
+  }
+
+  void setRemainMove( const PointF& move )
+  {
+    kinematics->remainX[ slot ] = move.getX();
+    kinematics->remainY[ slot ] = move.getY();
+  }
 
   float getSpeed() const
   {
-    return speedMultiplier * speed;
+    return kinematics->speedMultiplier[ slot ] * kinematics->speed[ slot ];
+  }
+
+  void setDirection( Direction direction )
+  {
+    action.direction = direction;
+    kinematics->direction[ slot ] = direction;
+  }
+
+  void setAction( Walker::Action value )
+  {
+    action.action = value;
+    kinematics->setFlag( slot, WalkerKinematics::moving, value == Walker::acMove );
+  }
+
+  const Tile& getTile()
+  {
+    const TilePos pos = getPos();
+    if( !tile || tile->getIJ() != pos )
+    {
+      tile = &city->getTilemap().at( pos );
+    }
+
+    return *tile;
   }
 
   void updateSpeedMultiplier( const Tile& tile ) 
   {
-    speedMultiplier = (tile.getFlag( Tile::tlRoad ) || tile.getFlag( Tile::tlGarden )) ? 1.f : 0.5f;
+    kinematics->speedMultiplier[ slot ] = (tile.getFlag( Tile::tlRoad ) || tile.getFlag( Tile::tlGarden )) ? 1.f : 0.5f;
   }
 };
 
 Walker::Walker( CityPtr city ) : _d( new Impl )
 {
   _d->city = city;
-  _d->action.action = Walker::acMove;
-  _d->action.direction = constants::noneDirection;
+  _d->kinematics = city->getWalkerKinematics();
+  _d->slot = _d->kinematics->alloc();  // default speed 1, mid tile at 7,7
+  _d->setAction( Walker::acMove );
+  _d->setDirection( constants::noneDirection );
   _d->walkerType = walker::unknown;
   _d->walkerGraphic = gfx::unknown;
   _d->health = 100;
-
-  _d->speed = 1.f;  // default speed
-  _d->speedMultiplier = 1.f;
   _d->isDeleted = false;
+  _d->tile = 0;
 
-  _d->midTilePos = Point( 7, 7 );
-  _d->remainMove = PointF( 0, 0 );
+  WalkerHelper::updateStatistic( walker::all, walker::unknown );
 }
 
 Walker::~Walker()
 {
+  _d->kinematics->free( _d->slot );
+  WalkerHelper::updateStatistic( _d->walkerType, walker::all );
 }
 
 walker::Type Walker::getType() const
@@ -98,9 +182,13 @@ void Walker::timeStep(const unsigned long time)
   switch(_d->action.action)
   {
   case Walker::acMove:
-    walk();
+    // city has moved walkers which stay inside their tile already
+    if( !_d->kinematics->isAdvanced( _d->slot ) )
+    {
+      walk();
+    }
 
-    if( _d->speed > 0.f )
+    if( _d->kinematics->speed[ _d->slot ] > 0.f )
     {
       _updateAnimation( time );
     }
@@ -132,32 +220,33 @@ bool Walker::isDeleted() const
 
 void Walker::setIJ( const TilePos& pos )
 {
-   _d->pos = pos;
+   _d->setPos( pos );
 
-   _d->tileOffset = _d->midTilePos;
+   _d->setTileOffset( _d->getMidTilePos() );
 
-   _d->posOnMap = Point( _d->pos.getI(), _d->pos.getJ() ) * 15 + _d->tileOffset;
+   _d->setPosOnMap( Point( pos.getI(), pos.getJ() ) * 15 + _d->getTileOffset() );
 }
 
 int Walker::getI() const
 {
-   return _d->pos.getI();
+   return _d->kinematics->tileI[ _d->slot ];
 }
 
 int Walker::getJ() const
 {
-   return _d->pos.getJ();
+   return _d->kinematics->tileJ[ _d->slot ];
 }
 
 Point Walker::getPosition() const
 {
-  return Point( 2*(_d->posOnMap.getX() + _d->posOnMap.getY()),
-                _d->posOnMap.getX() - _d->posOnMap.getY() );
+  const Point posOnMap = _d->getPosOnMap();
+  return Point( 2*(posOnMap.getX() + posOnMap.getY()),
+                posOnMap.getX() - posOnMap.getY() );
 }
 
 Point Walker::getSubPosition() const
 {
-  return _d->tileOffset;
+  return _d->getTileOffset();
 }
 
 void Walker::setPathway( const Pathway& pathway)
@@ -170,7 +259,7 @@ void Walker::setPathway( const Pathway& pathway)
 
 void Walker::setSpeed(const float speed)
 {
-   _d->speed = speed;
+   _d->kinematics->speed[ _d->slot ] = speed;
 }
 
 gfx::Type Walker::_getAnimationType() const
@@ -229,130 +318,102 @@ void Walker::dec(int &ioSI, int &ioI, int &ioAmount, const int iMidPos, bool &oN
 
 void Walker::walk()
 {
-   if( constants::noneDirection == _d->action.direction )
-   {
-      // nothing to do
-      return;
-   }
-
-   Tile& tile = _d->city->getTilemap().at( getIJ() );
-    
-   switch (_d->action.direction)
-   {
-   case constants::north:
-   case constants::south:
-     _d->remainMove += PointF( 0, _d->getSpeed() );
-   break;
-
-   case constants::east:
-   case constants::west:
-     _d->remainMove += PointF( _d->getSpeed(), 0 );
-   break;
-
-   case constants::northEast:
-   case constants::southWest:
-   case constants::southEast:
-   case constants::northWest:
-      _d->remainMove += PointF( _d->getSpeed() * 0.7f, _d->getSpeed() * 0.7f );
-   break;
-
-   default:
-      Logger::warning( "Invalid move direction: %d", _d->action.direction );
-      _d->action.direction = constants::noneDirection;
-   break;
-   }
-   
-
-   bool newTile = false;
-   bool midTile = false;
-   int amountI = int(_d->remainMove.getX());
-   int amountJ = int(_d->remainMove.getY());
-   _d->remainMove -= Point( amountI, amountJ ).toPointF();
-
-   // std::cout << "walker step, amount :" << amount << std::endl;
-   int tmpX = _d->tileOffset.getX();
-   int tmpY = _d->tileOffset.getY();
-   int tmpJ = _d->pos.getJ();
-   int tmpI = _d->pos.getI();
-   while (amountI+amountJ > 0)
-   {
-      switch (_d->action.direction)
-      {
-      case constants::north:
-         inc(tmpY, tmpJ, amountJ, _d->midTilePos.getY(), newTile, midTile);
-      break;
-
-      case constants::northEast:
-         inc(tmpY, tmpJ, amountJ, _d->midTilePos.getY(), newTile, midTile);
-         inc(tmpX, tmpI, amountI, _d->midTilePos.getX(), newTile, midTile);
-      break;
+  const Direction direction = _d->action.direction;
+  if( constants::noneDirection == direction )
+  {
+    // nothing to do
+    return;
+  }
 
-      case constants::east:
-         inc(tmpX, tmpI, amountI, _d->midTilePos.getX(), newTile, midTile);
-      break;
+  if( direction >= constants::countDirection )
+  {
+    Logger::warning( "Invalid move direction: %d", direction );
+    _d->setDirection( constants::noneDirection );
+    return;
+  }
 
-      case constants::southEast:
-         dec(tmpY, tmpJ, amountJ, _d->midTilePos.getY(), newTile, midTile);
-         inc(tmpX, tmpI, amountI, _d->midTilePos.getX(), newTile, midTile);
-      break;
+  // overlay offset is taken from the tile where walker started this step
+  const Tile& startTile = _d->getTile();
 
-      case constants::south:
-         dec(tmpY, tmpJ, amountJ, _d->midTilePos.getY(), newTile, midTile);
-      break;
+  const int stepI = WalkerKinematics::axisI[ direction ];
+  const int stepJ = WalkerKinematics::axisJ[ direction ];
+  const float speed = _d->getSpeed() * ( (stepI != 0 && stepJ != 0) ? 0.7f : 1.f );
+  PointF remainMove = _d->getRemainMove() + PointF( stepI != 0 ? speed : 0.f, stepJ != 0 ? speed : 0.f );
 
-      case constants::southWest:
-         dec(tmpY, tmpJ, amountJ, _d->midTilePos.getY(), newTile, midTile);
-         dec(tmpX, tmpI, amountI, _d->midTilePos.getX(), newTile, midTile);
-      break;
+  int amountI = int(remainMove.getX());
+  int amountJ = int(remainMove.getY());
+  _d->setRemainMove( remainMove - Point( amountI, amountJ ).toPointF() );
 
-      case constants::west:
-         dec(tmpX, tmpI, amountI, _d->midTilePos.getX(), newTile, midTile);
+  // plain kinematic step until movement is exhausted, virtual callbacks
+  // are called only when walker crossed tile border or tile center
+  while( amountI+amountJ > 0 )
+  {
+    const Direction curDirection = _d->action.direction;
+    if( curDirection == constants::noneDirection || curDirection >= constants::countDirection )
+    {
       break;
+    }
 
-      case constants::northWest:
-         inc(tmpY, tmpJ, amountJ, _d->midTilePos.getY(), newTile, midTile);
-         dec(tmpX, tmpI, amountI, _d->midTilePos.getX(), newTile, midTile);
-      break;
+    bool newTile = false;
+    bool midTile = false;
+    const Point midTilePos = _d->getMidTilePos();
+    const TilePos pos = _d->getPos();
+    int tmpX = _d->kinematics->offsetX[ _d->slot ];
+    int tmpY = _d->kinematics->offsetY[ _d->slot ];
+    int tmpJ = pos.getJ();
+    int tmpI = pos.getI();
+    const int lastAmount = amountI + amountJ;
+
+    switch( WalkerKinematics::axisJ[ curDirection ] )
+    {
+    case 1: inc(tmpY, tmpJ, amountJ, midTilePos.getY(), newTile, midTile); break;
+    case -1: dec(tmpY, tmpJ, amountJ, midTilePos.getY(), newTile, midTile); break;
+    default: break;
+    }
 
-      default:
-         Logger::warning( "Invalid move direction: %d", _d->action.direction);
-         _d->action.direction = constants::noneDirection;
-      break;
-      }
+    switch( WalkerKinematics::axisI[ curDirection ] )
+    {
+    case 1: inc(tmpX, tmpI, amountI, midTilePos.getX(), newTile, midTile); break;
+    case -1: dec(tmpX, tmpI, amountI, midTilePos.getX(), newTile, midTile); break;
+    default: break;
+    }
 
-      _d->tileOffset = Point( tmpX, tmpY );
-      _d->pos = TilePos( tmpI, tmpJ );
+    _d->setTileOffset( Point( tmpX, tmpY ) );
+    _d->setPos( TilePos( tmpI, tmpJ ) );
 
-      if (newTile)
-      {
-         // walker is now on a new tile!
-         onNewTile();
-      }
+    if (newTile)
+    {
+      // walker is now on a new tile!
+      onNewTile();
+    }
 
-      if (midTile)
-      {
-         // walker is now on the middle of the tile!
-         onMidTile();
-      }
+    if (midTile)
+    {
+      // walker is now on the middle of the tile!
+      onMidTile();
+    }
 
-      // if (midTile) std::cout << "walker mid tile" << std::endl;
-      // if (newTile) std::cout << "walker new tile" << std::endl;
-      // if (amount != 0) std::cout << "walker remaining step :" << amount << std::endl;
-   }
+    if( amountI + amountJ == lastAmount )
+    {
+      // direction was changed to axis without movement amount
+      break;
+    }
+  }
 
-   Point overlayOffset = tile.getOverlay().isValid()
-                              ? tile.getOverlay()->getOffset( _d->tileOffset )
-                              : Point( 0, 0 );
+  const Point tileOffset = _d->getTileOffset();
+  TileOverlayPtr overlay = startTile.getOverlay();
+  Point overlayOffset = overlay.isValid()
+                          ? overlay->getOffset( tileOffset )
+                          : Point( 0, 0 );
 
-   _d->posOnMap = Point( _d->pos.getI(), _d->pos.getJ() )*15 + _d->tileOffset + overlayOffset;
+  const TilePos pos = _d->getPos();
+  _d->setPosOnMap( Point( pos.getI(), pos.getJ() )*15 + tileOffset + overlayOffset );
 }
 
 
 void Walker::onNewTile()
 {
-   Tilemap& tilemap = _d->city->getTilemap();
-   Tile& currentTile = tilemap.at( _d->pos );
-   _d->updateSpeedMultiplier( currentTile );
+   _d->updateSpeedMultiplier( _d->getTile() );
 }
 
 
@@ -373,7 +434,7 @@ void Walker::onMidTile()
 
 void Walker::onDestination()
 {
-  _d->action.action = acNone;  // stop moving
+  _d->setAction( acNone );  // stop moving
   _d->animation = Animation();
 }
 
@@ -386,7 +447,7 @@ void Walker::onNewDirection()
 void Walker::computeDirection()
 {
   Direction lastDirection = _d->action.direction;
-  _d->action.direction = _d->pathWay.getNextDirection();
+  _d->setDirection( _d->pathWay.getNextDirection() );
 
   if( lastDirection != _d->action.direction )
   {
@@ -489,14 +550,14 @@ void Walker::save( VariantMap& stream ) const
   stream[ "health" ] = _d->health;
   stream[ "action" ] = (int)_d->action.action;
   stream[ "direction" ] = (int)_d->action.direction;
-  stream[ "pos" ] = _d->pos;
-  stream[ "tileoffset" ] = _d->tileOffset;
-  stream[ "mappos" ] = _d->posOnMap;
-  stream[ "speed" ] = _d->speed;
-  stream[ "midTile" ] = _d->midTilePos;
-  stream[ "speedMul" ] = (float)_d->speedMultiplier;
+  stream[ "pos" ] = _d->getPos();
+  stream[ "tileoffset" ] = _d->getTileOffset();
+  stream[ "mappos" ] = _d->getPosOnMap();
+  stream[ "speed" ] = _d->kinematics->speed[ _d->slot ];
+  stream[ "midTile" ] = _d->getMidTilePos();
+  stream[ "speedMul" ] = _d->kinematics->speedMultiplier[ _d->slot ];
   stream[ "uid" ] = (unsigned int)_d->uid;
-  stream[ "remainmove" ] = _d->remainMove;
+  stream[ "remainmove" ] = _d->getRemainMove();
 }
 
 void Walker::load( const VariantMap& stream)
@@ -505,24 +566,25 @@ void Walker::load( const VariantMap& stream)
 
   _d->pathWay.init( tmap, tmap.at( 0, 0 ) );
   _d->pathWay.load( stream.get( "pathway" ).toMap() );
-  _d->action.action = (Walker::Action) stream.get( "action" ).toInt();
-  _d->action.direction = (Direction) stream.get( "direction" ).toInt();
-  _d->pos = stream.get( "pos" ).toTilePos();
-  _d->tileOffset = stream.get( "tileoffset" ).toPoint();
-  _d->posOnMap = stream.get( "mappos" ).toPoint();
+  _d->setAction( (Walker::Action) stream.get( "action" ).toInt() );
+  _d->setDirection( (Direction) stream.get( "direction" ).toInt() );
+  _d->setPos( stream.get( "pos" ).toTilePos() );
+  _d->setTileOffset( stream.get( "tileoffset" ).toPoint() );
+  _d->setPosOnMap( stream.get( "mappos" ).toPoint() );
   _d->uid = (UniqueId)stream.get( "uid" ).toInt();
-  _d->speedMultiplier = stream.get( "speedMul" ).toFloat();
+  float& speedMultiplier = _d->kinematics->speedMultiplier[ _d->slot ];
+  speedMultiplier = stream.get( "speedMul" ).toFloat();
   _d->name = stream.get( "name" ).toString();
   
-  _OC3_DEBUG_BREAK_IF( _d->speedMultiplier < 0.1 );
-  if( _d->speedMultiplier < 0.1 ) //Sometime this have this error in save file
+  _OC3_DEBUG_BREAK_IF( speedMultiplier < 0.1 );
+  if( speedMultiplier < 0.1 ) //Sometime this have this error in save file
   {
-    _d->speedMultiplier = 1;
+    speedMultiplier = 1;
   }
 
-  _d->speed = stream.get( "speed" ).toFloat();
-  _d->midTilePos = stream.get( "midTile" ).toPoint();
-  _d->remainMove = stream.get( "remainmove" ).toPointF();
+  _d->kinematics->speed[ _d->slot ] = stream.get( "speed" ).toFloat();
+  _d->setMidTilePos( stream.get( "midTile" ).toPoint() );
+  _d->setRemainMove( stream.get( "remainmove" ).toPointF() );
   _d->health = (double)stream.get( "health" );
 }
 
@@ -533,12 +595,13 @@ void Walker::addAbility(AbilityPtr ability)
 
 TilePos Walker::getIJ() const
 {
-    return _d->pos;
+    return _d->getPos();
 }
 
 void Walker::deleteLater()
 {
    _d->isDeleted = true;
+   _d->kinematics->setFlag( _d->slot, WalkerKinematics::deleted, true );
 }
 
 void Walker::setUniqueId( const UniqueId uid )
@@ -565,7 +628,7 @@ void Walker::turn(TilePos pos)
 
   if( _d->action.direction != directions[ angle ] )
   {
-    _d->action.direction = directions[ angle ];
+    _d->setDirection( directions[ angle ] );
     onNewDirection();
     getMainPicture();
   }
@@ -585,12 +648,12 @@ void Walker::_updatePathway(const Pathway& pathway)
 
 void Walker::_setAction( Walker::Action action )
 {
-  _d->action.action = action;
+  _d->setAction( action );
 }
 
 void Walker::_setDirection(constants::Direction direction )
 {
-  _d->action.direction = direction;
+  _d->setDirection( direction );
 }
 
 void Walker::_setAnimation( gfx::Type type)
@@ -600,6 +663,7 @@ void Walker::_setAnimation( gfx::Type type)
 
 void Walker::_setType(walker::Type type)
 {
+  WalkerHelper::updateStatistic( _d->walkerType, type );
   _d->walkerType = type;
 }
 
@@ -621,9 +685,14 @@ void Walker::_updateAnimation( const unsigned int time )
   }
 }
 
+void Walker::_setBatchWalk( bool enabled )
+{
+  _d->kinematics->setFlag( _d->slot, WalkerKinematics::batch, enabled );
+}
+
 void Walker::go()
 {
-  _d->action.action = acMove;       // default action
+  _d->setAction( acMove );       // default action
 }
 
 void Walker::die()
@@ -644,6 +713,17 @@ public:
   typedef std::map< walker::Type, std::string > PrettyNames;
   PrettyNames prettyTypenames;
 
+  struct Counter
+  {
+    unsigned int live;
+    unsigned int peak;
+
+    Counter() : live( 0 ), peak( 0 ) {}
+  };
+
+  typedef std::map< walker::Type, Counter > Counters;
+  Counters counters;
+
   void append( walker::Type type, const std::string& typeName, const std::string& prettyTypename )
   {
     EnumsHelper<walker::Type>::append( type, typeName );
@@ -740,6 +820,56 @@ Picture WalkerHelper::getBigPicture(walker::Type type)
   return index >= 0 ? Picture::load( "bigpeople", index ) : Picture::getInvalid();
 }
 
+void WalkerHelper::updateStatistic( walker::Type oldType, walker::Type newType )
+{
+  if( oldType == newType )
+    return;
+
+  Impl::Counters& counters = instance()._d->counters;
+  if( oldType != walker::all )
+  {
+    counters[ oldType ].live--;
+  }
+
+  if( newType != walker::all )
+  {
+    Impl::Counter& counter = counters[ newType ];
+    counter.live++;
+    counter.peak = std::max( counter.peak, counter.live );
+  }
+}
+
+unsigned int WalkerHelper::getLiveCount( walker::Type type )
+{
+  Impl::Counters& counters = instance()._d->counters;
+  Impl::Counters::iterator it = counters.find( type );
+  return it != counters.end() ? it->second.live : 0;
+}
+
+unsigned int WalkerHelper::getPeakCount( walker::Type type )
+{
+  Impl::Counters& counters = instance()._d->counters;
+  Impl::Counters::iterator it = counters.find( type );
+  return it != counters.end() ? it->second.peak : 0;
+}
+
+void WalkerHelper::printStatistic()
+{
+  Impl::Counters& counters = instance()._d->counters;
+  for( Impl::Counters::iterator it=counters.begin(); it != counters.end(); it++ )
+  {
+    std::string name = instance()._d->findName( it->first );
+    if( name.empty() )
+    {
+      name = StringHelper::format( 0xff, "type%d", it->first );
+    }
+
+    Logger::warning( "Walkers %s: live %d peak %d", name.c_str(), it->second.live, it->second.peak );
+  }
+
+  MemoryPool::instance().printStatistic();
+}
+
 WalkerHelper::~WalkerHelper()
 {
 }
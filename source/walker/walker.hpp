@@ -32,6 +32,7 @@
 #include "core/smartptr.hpp"
 #include "core/scopedptr.hpp"
 #include "core/predefinitions.hpp"
+#include "core/mempool.hpp"
 #include "gfx/constants.hpp"
 
 typedef unsigned int UniqueId;
@@ -45,6 +46,9 @@ public:
   Walker( CityPtr city );
   virtual ~Walker();
 
+  // walkers are spawned and dropped all the time, keep them in pool
+  OC3_POOLED_ALLOCATION
+
   virtual void timeStep(const unsigned long time);  // performs one simulation step
   virtual constants::walker::Type getType() const;
   // position and movement
@@ -111,6 +115,9 @@ protected:
    CityPtr _getCity() const;
    void _setHealth( double value );
    void _updateAnimation(const unsigned int time);
+   // city moves walkers inside a tile before their timeStep() is called, walker
+   // which must do something before walk() in its timeStep() moves itself
+   void _setBatchWalk( bool enabled );
 
 private:
    /* useful method for subtile movement computation
@@ -148,6 +155,12 @@ public:
   static std::string getPrettyTypeName( constants::walker::Type type );
   static Picture getBigPicture( constants::walker::Type type );
 
+  // live/peak walker counters by type
+  static void updateStatistic( constants::walker::Type oldType, constants::walker::Type newType );
+  static unsigned int getLiveCount( constants::walker::Type type );
+  static unsigned int getPeakCount( constants::walker::Type type );
+  static void printStatistic();
+
   virtual ~WalkerHelper();
 private:
   WalkerHelper();